@@ -0,0 +1,36 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Tiny timing helpers shared by the sources/bench/ executables.
+// Deliberately avoids raylib's GetTime(), which needs an initialized window.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Keeps the optimizer from discarding work whose result is otherwise unused.
+static volatile uint64_t bench_sink;
+
+// Deterministic xorshift32 for bench inputs, so every run measures the same data.
+static uint32_t bench_xorshift(uint32_t *state) {
+    *state ^= *state << 13; *state ^= *state >> 17; *state ^= *state << 5;
+    return *state;
+}
+
+// Runs `body` for `iters` iterations and yields the mean cost of one iteration in nanoseconds.
+#define BENCH_NS_PER_ITER(out_ns, iters, body)                        \
+    do {                                                              \
+        const uint64_t bench_start_ = bench_now_ns();                 \
+        for (int bench_i_ = 0; bench_i_ < (iters); bench_i_++) {      \
+            body;                                                     \
+        }                                                             \
+        (out_ns) = (double)(bench_now_ns() - bench_start_) / (iters); \
+    } while (0)
+
+#endif //BENCH_H
@@ -0,0 +1,125 @@
+// Collision query cost with and without the broadphase: MOVERS platformer
+// movers (8x8 rects, solid to each other) at a constant density, over a
+// tilemap grid collider that covers the whole level, stepped by the real
+// move_platformer and bounce_in_bounds systems. The level grows with the
+// mover count, so a full scan gets slower per mover while the broadphase
+// stays flat. Grid and tree backends run the same spawn as the full scan
+// and must end bit-identical to it.
+
+#include "bench.h"
+#include "game/collision/broadphase.h"
+#include "game/collision/collision.h"
+#include "game/systems/ecs_systems.h"
+
+#include <math.h>
+#include <string.h>
+
+#define MAX_MOVERS   10000
+#define MAX_PER_ROW  100 // sqrt(MAX_MOVERS)
+#define SPACING      48  // px of level side per mover in a row
+#define TILE         16
+#define MAX_TILES    (MAX_PER_ROW * SPACING / TILE) // per axis
+#define SCAN         -1 // no broadphase, in place of a BroadphaseKind
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena      g_arena;
+static Arena      g_scratch;
+static World      g_world;
+static Broadphase g_broadphase;
+static uint8_t    g_solid  [MAX_TILES * MAX_TILES];
+static EntityId   g_ids    [MAX_MOVERS];
+static Position   g_result [MAX_MOVERS];
+
+static float level_side(const uint32_t movers) {
+    return ceilf(sqrtf((float)movers)) * SPACING;
+}
+
+static void populate(const uint32_t movers, const int kind) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    world_init(&g_world, &g_arena, WORLD_STORAGE_SPARSE);
+    g_scratch = arena_sub(&g_arena, SCRATCH_ARENA_BYTES, ARENA_TAG_SCRATCH);
+    if (kind != SCAN) {
+        broadphase_init(&g_broadphase, &g_arena, (BroadphaseKind)kind, movers + 1);
+        g_world.broadphase = &g_broadphase;
+    }
+
+    // A few solid tiles scattered over the level, as a map's "solid" layer would be.
+    const float side  = level_side(movers);
+    const int   tiles = (int)(side / TILE);
+    uint32_t state = 0x2545F491u;
+    for (int i = 0; i < tiles * tiles; i++) g_solid[i] = (bench_xorshift(&state) % 16) == 0;
+    Prefab map = (Prefab){
+        .components = COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER),
+        .collider   = collider_grid(TILE, tiles, tiles, collide_grid_alloc(&g_arena, tiles, tiles, true, ARENA_TAG_COLLISION),
+                                    true, COL_SOLID, COL_NONE),
+    };
+    collide_grid_pack(&map.collider.shape.as.grid, g_solid);
+    world_spawn_batch(&g_world, &map, 1, g_ids);
+
+    const Prefab mover = (Prefab){
+        .components      = COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY) |
+                           COMPONENT_BIT(COMPONENT_COLLIDER) | COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER),
+        .collider        = collider_rect((Vector2){ 0, 0 }, (Vector2){ 8, 8 }, COL_SOLID, COL_SOLID),
+        .move_platformer = { MOVE_PLATFORMER_DEFAULTS },
+    };
+    world_spawn_batch(&g_world, &mover, movers, g_ids);
+    for (uint32_t i = 0; i < movers; i++) {
+        *world_get_position(&g_world, g_ids[i]) = (Position){
+            (float)(bench_xorshift(&state) % (uint32_t)(side - 8)),
+            (float)(bench_xorshift(&state) % (uint32_t)(side - 8)),
+        };
+        // Up to 600 px/s on each axis: about 10 px per tick.
+        world_get_velocity(&g_world, g_ids[i])->value = (Vector2){
+            (float)(bench_xorshift(&state) % 1201) - 600.0f,
+            (float)(bench_xorshift(&state) % 1201) - 600.0f,
+        };
+    }
+}
+
+static void tick(const uint32_t movers, const int kind) {
+    const float  dt     = 1.0f / 60.0f;
+    const float  side   = level_side(movers);
+    const Bounds bounds = { 0, 0, side, side };
+    if (kind != SCAN) broadphase_update(&g_broadphase, &g_world);
+    sys_move_platformer (&g_world, &g_scratch, dt);
+    sys_bounce_in_bounds(&g_world, bounds);
+}
+
+// ns per tick over `ticks` ticks from a fresh spawn; leaves the final positions in g_result.
+static double run(const uint32_t movers, const int ticks, const int kind) {
+    populate(movers, kind);
+    double ns;
+    BENCH_NS_PER_ITER(ns, ticks, tick(movers, kind));
+    for (uint32_t i = 0; i < movers; i++) g_result[i] = *world_get_position(&g_world, g_ids[i]);
+    return ns;
+}
+
+static void compare(const uint32_t movers, const int ticks) {
+    static Position scan_result[MAX_MOVERS];
+    const double scan_ns = run(movers, ticks, SCAN);
+    memcpy(scan_result, g_result, sizeof(Position) * movers);
+    const double grid_ns = run(movers, ticks, BROADPHASE_GRID);
+    const bool grid_same = memcmp(scan_result, g_result, sizeof(Position) * movers) == 0;
+    const double tree_ns = run(movers, ticks, BROADPHASE_TREE);
+    const bool tree_same = memcmp(scan_result, g_result, sizeof(Position) * movers) == 0;
+
+    printf("%8u %6d %12.3f %12.3f %12.3f %10s\n", movers, ticks,
+        scan_ns / 1e6, grid_ns / 1e6, tree_ns / 1e6, grid_same && tree_same ? "identical" : "MISMATCH");
+    bench_sink += (uint64_t)g_result[0].x;
+}
+
+int main(void) {
+    printf("platformer movers over a tilemap grid, ms per tick\n");
+    printf("%8s %6s %12s %12s %12s %10s\n", "movers", "ticks", "full scan", "grid", "tree", "check");
+    compare(1000,  60);
+    compare(MAX_MOVERS, 3); // a full-scan tick at 10k takes seconds
+
+    // Broadphases alone, long enough for movers to pile up against each other.
+    const double grid_ns = run(MAX_MOVERS, 300, BROADPHASE_GRID);
+    printf("grid, %d movers, 300 ticks: %.3f ms per tick, %u entries\n",
+        MAX_MOVERS, grid_ns / 1e6, g_broadphase.entries.count);
+    const double tree_ns = run(MAX_MOVERS, 300, BROADPHASE_TREE);
+    printf("tree, %d movers, 300 ticks: %.3f ms per tick, height %d\n",
+        MAX_MOVERS, tree_ns / 1e6, aabb_tree_height(&g_broadphase.tree));
+    return 0;
+}
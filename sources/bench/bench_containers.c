@@ -0,0 +1,129 @@
+// Lookups at 10, 100 and 10k elements: linear search against the arena
+// containers, for the two shapes the game has. Integer keys are entity ids
+// (the render interpolation match); string keys are sprite names
+// (atlas_find_region). Every lookup hits, in a shuffled order, and each
+// method's checksum must agree.
+
+#include "bench.h"
+#include "shared/arena.h"
+#include "shared/array.h"
+#include "shared/hash_map.h"
+#include "shared/intern.h"
+
+#include <string.h>
+
+#define MAX_ELEMENTS 10000
+#define LOOKUPS      (1 << 20)
+#define NAME_LENGTH  32
+
+typedef ARRAY(uint64_t) U64Array;
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena    g_arena;
+static uint64_t g_ids   [MAX_ELEMENTS];
+static char     g_names [MAX_ELEMENTS][NAME_LENGTH];
+static uint32_t g_order [LOOKUPS]; // which element each lookup asks for
+
+// Ids spread like generational EntityIds: index in the low half, generation above.
+static void make_elements(const uint32_t count) {
+    uint32_t state = 0x9E3779B9u;
+    for (uint32_t i = 0; i < count; i++) {
+        g_ids[i] = (uint64_t)(bench_xorshift(&state) & 0xFF) << 32 | (i * 7 + 3);
+        snprintf(g_names[i], NAME_LENGTH, "hero_run_%04u_%c", i, 'a' + (char)(i % 26));
+    }
+    for (uint32_t i = 0; i < LOOKUPS; i++) g_order[i] = bench_xorshift(&state) % count;
+}
+
+static uint32_t linear_find_id(const uint32_t count, const uint64_t id) {
+    for (uint32_t i = 0; i < count; i++) if (g_ids[i] == id) return i;
+    return UINT32_MAX;
+}
+
+static uint32_t linear_find_name(const uint32_t count, const char *name) {
+    for (uint32_t i = 0; i < count; i++) if (strcmp(g_names[i], name) == 0) return i;
+    return UINT32_MAX;
+}
+
+// Fewer lookups for slow linear runs, so 10k elements doesn't take minutes.
+static int lookups_for(const uint32_t count, const bool linear) {
+    return linear && count > 100 ? LOOKUPS / 64 : LOOKUPS;
+}
+
+static void run(const uint32_t count) {
+    make_elements(count);
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+
+    HashMap by_id, by_name;
+    hash_map_init(&by_id,   &g_arena, count, ARENA_TAG_UNTAGGED);
+    hash_map_init(&by_name, &g_arena, count, ARENA_TAG_UNTAGGED);
+    Interner interner;
+    intern_init(&interner, &g_arena, count, ARENA_TAG_UNTAGGED);
+    for (uint32_t i = 0; i < count; i++) {
+        hash_map_put(&by_id,   g_ids[i], i);
+        hash_map_put(&by_name, hash_string(g_names[i]), i);
+        intern_add(&interner, g_names[i]);
+    }
+
+    double   ns[5];
+    uint64_t sums[5] = { 0 };
+    int      iters;
+
+    iters = lookups_for(count, true);
+    BENCH_NS_PER_ITER(ns[0], iters, sums[0] += linear_find_id(count, g_ids[g_order[bench_i_]]));
+    iters = lookups_for(count, false);
+    BENCH_NS_PER_ITER(ns[1], iters, {
+        uint32_t index = UINT32_MAX;
+        hash_map_get(&by_id, g_ids[g_order[bench_i_]], &index);
+        sums[1] += index;
+    });
+
+    iters = lookups_for(count, true);
+    BENCH_NS_PER_ITER(ns[2], iters, sums[2] += linear_find_name(count, g_names[g_order[bench_i_]]));
+    iters = lookups_for(count, false);
+    BENCH_NS_PER_ITER(ns[3], iters, {
+        const char *name  = g_names[g_order[bench_i_]];
+        uint32_t    index = UINT32_MAX;
+        if (hash_map_get(&by_name, hash_string(name), &index) && strcmp(g_names[index], name) != 0) index = UINT32_MAX;
+        sums[3] += index;
+    });
+    BENCH_NS_PER_ITER(ns[4], iters, sums[4] += intern_find(&interner, g_names[g_order[bench_i_]]) - 1);
+
+    // The linear runs did fewer lookups: compare over the common prefix.
+    const int common = lookups_for(count, true);
+    uint64_t  check  = 0;
+    for (int i = 0; i < common; i++) check += g_order[i];
+    const bool ok = sums[0] == check && sums[2] == check;
+    uint64_t   full = 0;
+    for (int i = 0; i < LOOKUPS; i++) full += g_order[i];
+    const bool ok_maps = sums[1] == full && sums[3] == full && sums[4] == full;
+
+    printf("%8u %12.1f %12.1f %12.1f %12.1f %12.1f %8s\n", count, ns[0], ns[1], ns[2], ns[3], ns[4],
+        ok && ok_maps ? "ok" : "MISMATCH");
+    bench_sink += sums[0] + sums[1] + sums[2] + sums[3] + sums[4];
+}
+
+// Appending 10k ids: the array grows in place while it is the arena's newest allocation.
+static void run_array(void) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    U64Array array;
+    double   ns;
+    BENCH_NS_PER_ITER(ns, 100, {
+        arena_reset(&g_arena);
+        ARRAY_INIT(&array, &g_arena, 0, ARENA_TAG_UNTAGGED);
+        for (uint64_t i = 0; i < MAX_ELEMENTS; i++) ARRAY_PUSH(&array, i);
+    });
+    printf("array push: %.2f ns/item, %zu arena bytes for %u items\n",
+        ns / MAX_ELEMENTS, g_arena.used, array.count);
+    bench_sink += array.items[array.count - 1];
+}
+
+int main(void) {
+    printf("ns per lookup, %d lookups (linear at 10k: %d)\n", LOOKUPS, LOOKUPS / 64);
+    printf("%8s %12s %12s %12s %12s %12s %8s\n",
+        "elements", "id linear", "id map", "name linear", "name map", "name intern", "check");
+    run(10);
+    run(100);
+    run(MAX_ELEMENTS);
+    run_array();
+    return 0;
+}
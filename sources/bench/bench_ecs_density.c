@@ -0,0 +1,59 @@
+// Per-tick cost of sys_animation and extract_render_snapshot as the share of
+// entities carrying the iterated components varies. ENTITIES entities are
+// alive and have a Position; only `density` of them also get a Renderable +
+// Animator, which is what the systems actually walk.
+// All instances share layer 0 so the snapshot's layer sort stays out of the numbers.
+
+#include "bench.h"
+#include "game/systems/ecs_systems.h"
+
+#define ENTITIES 4096
+#define TICKS    2000
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena          g_arena;
+static World          g_world;
+static Assets         g_assets;
+static RenderSnapshot g_snapshot;
+static TexRegion      g_frames[4];
+
+static void populate(World *world, const float density) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    world_init(world, &g_arena, WORLD_STORAGE_SPARSE);
+
+    const int stride = density > 0.0f ? (int)(1.0f / density + 0.5f) : ENTITIES + 1;
+    for (int i = 0; i < ENTITIES; i++) {
+        const EntityId entity = world_create_entity(world);
+        world_set_position(world, entity, (Position){ (float)(i % 64) * 16.0f, (float)(i / 64) * 16.0f });
+        if (i % stride != 0) continue;
+
+        world_set_renderable(world, entity, (Renderable){ RENDERABLE_DEFAULTS, .size = { 16, 16 } });
+        world_set_animator  (world, entity, (Animator){
+            ANIMATOR_DEFAULTS,
+            .mode          = ANIM_LOOP,
+            .frames        = (AtlasRegions){ .regions = g_frames, .count = 4 },
+            .frame_seconds = 0.1f,
+        });
+    }
+}
+
+int main(void) {
+    static const float densities[] = { 0.01f, 0.10f, 1.00f };
+
+    printf("entities: %d, ticks: %d\n", ENTITIES, TICKS);
+    printf("%-8s %10s %22s %32s\n", "density", "matching", "sys_animation ns/tick", "extract_render_snapshot ns/tick");
+
+    for (size_t d = 0; d < sizeof densities / sizeof densities[0]; d++) {
+        populate(&g_world, densities[d]);
+
+        double anim_ns, extract_ns;
+        BENCH_NS_PER_ITER(anim_ns,    TICKS, sys_animation(&g_world, 1.0f / 60.0f));
+        BENCH_NS_PER_ITER(extract_ns, TICKS, extract_render_snapshot(&g_world, &g_assets, &g_snapshot));
+        bench_sink += g_snapshot.count;
+
+        printf("%7.0f%% %10u %22.1f %32.1f\n",
+            densities[d] * 100.0f,
+            world_query_count(&g_world, world_query_cached(&g_world, COMPONENT_BIT(COMPONENT_ANIMATOR), 0)), anim_ns, extract_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Level-load spawn cost: ENEMIES enemies with the same six components as the
+// game's animated actors, created either the old way (create + one setter per
+// component per entity) or with one world_spawn_batch() from a Prefab.
+// The per-entity atlas lookup spawn_animated() used to do is not included,
+// so the setter column is a lower bound for the old path.
+
+#include "bench.h"
+#include "game/systems/ecs_systems.h"
+#include "game/collision/collision.h"
+
+#define ENEMIES 5000
+#define ROUNDS  200
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena     g_arena;
+static World     g_world;
+static Prefab    g_prefab;
+static TexRegion g_frames[4];
+static EntityId  g_ids[ENEMIES];
+
+static void reset(const WorldStorage storage) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    world_init(&g_world, &g_arena, storage);
+    // Register what the game's systems query, so list upkeep is part of the cost.
+    sys_integrate_velocity(&g_world, 0.0f);
+    sys_move_platformer   (&g_world, NULL, 0.0f);
+    sys_animation         (&g_world, 0.0f);
+}
+
+static void spawn_with_setters(World *world) {
+    for (int i = 0; i < ENEMIES; i++) {
+        const EntityId entity = world_create_entity(world);
+        world_set_position       (world, entity, g_prefab.position);
+        world_set_velocity       (world, entity, g_prefab.velocity);
+        world_set_renderable     (world, entity, g_prefab.renderable);
+        world_set_collider       (world, entity, g_prefab.collider);
+        world_set_move_platformer(world, entity, g_prefab.move_platformer);
+        world_set_animator       (world, entity, g_prefab.animator);
+    }
+}
+
+int main(void) {
+    static const char *const storage_names[] = { "sparse", "archetype" };
+    const Vector2 size = (Vector2){ 16, 16 };
+
+    g_prefab = (Prefab){
+        .components      = COMPONENT_BIT(COMPONENT_POSITION)   | COMPONENT_BIT(COMPONENT_VELOCITY) |
+                           COMPONENT_BIT(COMPONENT_RENDERABLE) | COMPONENT_BIT(COMPONENT_COLLIDER) |
+                           COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER) | COMPONENT_BIT(COMPONENT_ANIMATOR),
+        .renderable      = (Renderable){ RENDERABLE_DEFAULTS, .size = size },
+        .collider        = collider_rect((Vector2){ 0, 0 }, size, COL_PLAYER, COL_PLAYER | COL_SOLID),
+        .move_platformer = (MovePlatformer){ MOVE_PLATFORMER_DEFAULTS },
+        .animator        = (Animator){
+            ANIMATOR_DEFAULTS,
+            .mode          = ANIM_LOOP,
+            .frames        = { .regions = g_frames, .count = 4 },
+            .frame_seconds = 0.1f,
+        },
+    };
+
+    printf("enemies: %d, rounds: %d\n", ENEMIES, ROUNDS);
+    printf("%-10s %20s %20s\n", "storage", "setters us/level", "spawn_batch us/level");
+
+    for (int storage = 0; storage < 2; storage++) {
+        double setters_ns = 0.0, batch_ns = 0.0;
+        for (int round = 0; round < ROUNDS; round++) {
+            double ns;
+            reset((WorldStorage)storage);
+            BENCH_NS_PER_ITER(ns, 1, spawn_with_setters(&g_world));
+            setters_ns += ns;
+
+            reset((WorldStorage)storage);
+            BENCH_NS_PER_ITER(ns, 1, bench_sink += world_spawn_batch(&g_world, &g_prefab, ENEMIES, g_ids));
+            batch_ns += ns;
+        }
+        printf("%-10s %20.1f %20.1f\n", storage_names[storage], setters_ns / ROUNDS / 1000.0, batch_ns / ROUNDS / 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Sparse-set vs archetype component storage on two entity mixes:
+//   projectiles: every entity is Position + Velocity + Renderable, one archetype
+//   mixed:       Position on all, Velocity / Renderable / Animator / Collider on
+//                overlapping subsets, so entities spread over many archetypes
+// Per-tick cost of the systems that stream components, plus a churn tick that
+// spawns and destroys CHURN projectiles (the archetype backend's weak spot).
+// All instances share layer 0 so the snapshot's layer sort stays out of the numbers.
+
+#include "bench.h"
+#include "game/systems/ecs_systems.h"
+
+#define ENTITIES 4096
+#define TICKS    2000
+#define CHURN    256
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena          g_arena;
+static World          g_world;
+static Assets         g_assets;
+static RenderSnapshot g_snapshot;
+static TexRegion      g_frames[4];
+static EntityId       g_churn[CHURN];
+
+static const Animator ANIMATOR = {
+    ANIMATOR_DEFAULTS,
+    .mode          = ANIM_LOOP,
+    .frames        = { .regions = g_frames, .count = 4 },
+    .frame_seconds = 0.1f,
+};
+
+static EntityId spawn_projectile(World *world, const int i) {
+    const EntityId entity = world_create_entity(world);
+    world_set_position  (world, entity, (Position){ (float)(i % 64) * 16.0f, (float)(i / 64) * 16.0f });
+    world_set_velocity  (world, entity, (Velocity){ .value = { 60.0f, -30.0f } });
+    world_set_renderable(world, entity, (Renderable){ RENDERABLE_DEFAULTS, .size = { 4, 4 }, .scale_settle_secs = 0.1f });
+    return entity;
+}
+
+static void populate(World *world, const WorldStorage storage, const bool mixed) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    world_init(world, &g_arena, storage);
+
+    for (int i = 0; i < ENTITIES; i++) {
+        if (!mixed) {
+            spawn_projectile(world, i);
+            continue;
+        }
+        const EntityId entity = world_create_entity(world);
+        world_set_position(world, entity, (Position){ (float)(i % 64) * 16.0f, (float)(i / 64) * 16.0f });
+        if (i % 2 == 0) world_set_velocity  (world, entity, (Velocity){ .value = { 60.0f, -30.0f } });
+        if (i % 3 == 0) world_set_renderable(world, entity, (Renderable){ RENDERABLE_DEFAULTS, .size = { 16, 16 }, .scale_settle_secs = 0.1f });
+        if (i % 6 == 0) world_set_animator  (world, entity, ANIMATOR);
+        if (i % 5 == 0) world_set_collider  (world, entity, (Collider){ 0 });
+    }
+}
+
+static void churn(World *world) {
+    for (int i = 0; i < CHURN; i++) g_churn[i] = spawn_projectile(world, i);
+    for (int i = 0; i < CHURN; i++) world_destroy_entity(world, g_churn[i]);
+}
+
+int main(void) {
+    static const char *const storage_names[] = { "sparse", "archetype" };
+    static const char *const mix_names[]     = { "projectiles", "mixed" };
+    const float dt = 1.0f / 60.0f;
+
+    printf("entities: %d, ticks: %d, churn: %d spawn+destroy per tick\n", ENTITIES, TICKS, CHURN);
+    printf("%-12s %-10s %16s %16s %16s %16s %16s   (ns/tick)\n",
+        "mix", "storage", "integrate", "scale_return", "animation", "extract", "churn");
+
+    for (int mix = 0; mix < 2; mix++) {
+        for (int storage = 0; storage < 2; storage++) {
+            populate(&g_world, (WorldStorage)storage, mix == 1);
+
+            double integrate_ns, scale_ns, anim_ns, extract_ns, churn_ns;
+            BENCH_NS_PER_ITER(integrate_ns, TICKS, sys_integrate_velocity(&g_world, dt));
+            BENCH_NS_PER_ITER(scale_ns,     TICKS, sys_scale_return(&g_world, dt));
+            BENCH_NS_PER_ITER(anim_ns,      TICKS, sys_animation(&g_world, dt));
+            BENCH_NS_PER_ITER(extract_ns,   TICKS, extract_render_snapshot(&g_world, &g_assets, &g_snapshot));
+            BENCH_NS_PER_ITER(churn_ns,     TICKS, churn(&g_world));
+            bench_sink += g_snapshot.count;
+
+            printf("%-12s %-10s %16.1f %16.1f %16.1f %16.1f %16.1f\n",
+                mix_names[mix], storage_names[storage], integrate_ns, scale_ns, anim_ns, extract_ns, churn_ns);
+        }
+    }
+    return 0;
+}
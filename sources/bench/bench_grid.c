@@ -0,0 +1,110 @@
+// Rect-vs-grid overlap cost: the bit-packed ShapeGrid through
+// collide_shape_overlaps(), with and without the block summary, against
+// the one-byte-per-cell layout it replaced, tested a CheckCollisionRecs()
+// per cell (kept below as the reference). A COLS x ROWS map with a solid
+// floor band and scattered solid tiles, queried at random positions by
+// rects from mover size to area-query size, some off the pixel grid. Every
+// answer must match the reference.
+
+#include "bench.h"
+#include "game/collision/collision.h"
+
+#include <math.h>
+
+#define COLS     1024
+#define ROWS     512
+#define CELL     16
+#define QUERIES  100000
+#define REPEATS  20
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena     g_arena;
+static uint8_t   g_cells  [COLS * ROWS];
+static Vector2   g_at     [QUERIES];
+static bool      g_expect [QUERIES];
+
+// The byte-per-cell overlap as it was before the grid was packed.
+static bool overlap_bytes(const ShapeRect *rect, const Vector2 pos, const uint8_t *cells) {
+    const float rect_left   = pos.x + rect->offset.x;
+    const float rect_top    = pos.y + rect->offset.y;
+    const float rect_right  = rect_left + rect->size.x;
+    const float rect_bottom = rect_top  + rect->size.y;
+
+    int col_min = (int)floorf(rect_left   / (float)CELL);
+    int col_max = (int)floorf(rect_right  / (float)CELL);
+    int row_min = (int)floorf(rect_top    / (float)CELL);
+    int row_max = (int)floorf(rect_bottom / (float)CELL);
+    if (col_min < 0)     col_min = 0;
+    if (row_min < 0)     row_min = 0;
+    if (col_max >= COLS) col_max = COLS - 1;
+    if (row_max >= ROWS) row_max = ROWS - 1;
+    if (col_min > col_max || row_min > row_max) return false;
+
+    for (int row = row_min; row <= row_max; row++) {
+        for (int col = col_min; col <= col_max; col++) {
+            if (!cells[row * COLS + col]) continue;
+            const Rectangle cell  = { (float)(col * CELL), (float)(row * CELL), (float)CELL, (float)CELL };
+            const Rectangle mover = { rect_left, rect_top, rect->size.x, rect->size.y };
+            if (CheckCollisionRecs(mover, cell)) return true;
+        }
+    }
+    return false;
+}
+
+static void run(const char *label, const Vector2 size, const bool off_grid,
+                const ColliderShape *packed, const ColliderShape *summarized) {
+    const ColliderShape mover = collider_rect((Vector2){ off_grid ? 0.5f : 0.0f, 0 }, size, COL_NONE, COL_NONE).shape;
+
+    uint32_t state = 0x9E3779B9u;
+    int hits = 0;
+    for (int i = 0; i < QUERIES; i++) {
+        g_at[i] = (Vector2){ (float)(bench_xorshift(&state) % (COLS * CELL)) - size.x * 0.5f,
+                             (float)(bench_xorshift(&state) % (ROWS * CELL)) - size.y * 0.5f };
+        g_expect[i] = overlap_bytes(&mover.as.rect, g_at[i], g_cells);
+        hits += g_expect[i];
+    }
+
+    bool   same = true;
+    double bytes_ns, packed_ns, summarized_ns;
+    int    sink = 0;
+    BENCH_NS_PER_ITER(bytes_ns, REPEATS, for (int i = 0; i < QUERIES; i++) sink += overlap_bytes(&mover.as.rect, g_at[i], g_cells));
+    BENCH_NS_PER_ITER(packed_ns, REPEATS, for (int i = 0; i < QUERIES; i++) {
+        const bool hit = collide_shape_overlaps(&mover, g_at[i], (Vector2){ 0, 0 }, packed, (Vector2){ 0, 0 });
+        same &= hit == g_expect[i];
+        sink += hit;
+    });
+    BENCH_NS_PER_ITER(summarized_ns, REPEATS, for (int i = 0; i < QUERIES; i++) {
+        const bool hit = collide_shape_overlaps(&mover, g_at[i], (Vector2){ 0, 0 }, summarized, (Vector2){ 0, 0 });
+        same &= hit == g_expect[i];
+        sink += hit;
+    });
+    bench_sink += (uint64_t)sink;
+
+    printf("%-22s %6.1f%% %10.1f %10.1f %10.1f %10s\n", label, 100.0 * hits / QUERIES,
+        bytes_ns / QUERIES, packed_ns / QUERIES, summarized_ns / QUERIES, same ? "identical" : "MISMATCH");
+}
+
+int main(void) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+
+    // Sparse tiles above a solid floor band, as a platformer level would have.
+    uint32_t state = 0x2545F491u;
+    for (int row = 0; row < ROWS; row++) {
+        for (int col = 0; col < COLS; col++) {
+            g_cells[row * COLS + col] = row >= ROWS - 32 || (bench_xorshift(&state) % 64) == 0;
+        }
+    }
+    Collider packed     = collider_grid(CELL, COLS, ROWS, collide_grid_alloc(&g_arena, COLS, ROWS, false, ARENA_TAG_COLLISION), false, COL_SOLID, COL_NONE);
+    Collider summarized = collider_grid(CELL, COLS, ROWS, collide_grid_alloc(&g_arena, COLS, ROWS, true,  ARENA_TAG_COLLISION), true,  COL_SOLID, COL_NONE);
+    collide_grid_pack(&packed.shape.as.grid,     g_cells);
+    collide_grid_pack(&summarized.shape.as.grid, g_cells);
+
+    printf("%dx%d grid: %d bytes as bytes, %zu packed, %zu with block summary\n", COLS, ROWS, COLS * ROWS,
+        sizeof(uint64_t) * collide_grid_words(COLS, ROWS, false), sizeof(uint64_t) * collide_grid_words(COLS, ROWS, true));
+    printf("%-22s %7s %10s %10s %10s %10s\n", "ns per query", "hits", "bytes", "packed", "summary", "check");
+    run("8x8 mover",            (Vector2){ 8, 8 },      false, &packed.shape, &summarized.shape);
+    run("12x20 mover, off grid", (Vector2){ 12, 20 },   true,  &packed.shape, &summarized.shape);
+    run("64x64 box",            (Vector2){ 64, 64 },    false, &packed.shape, &summarized.shape);
+    run("512x256 box",          (Vector2){ 512, 256 },  true,  &packed.shape, &summarized.shape);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Movement cost by speed: MOVERS projectiles (4x4 rects) fired in random
+// directions over a tilemap grid collider with a few sensors scattered on
+// it, stepped by the real move_platformer and bounce_in_bounds systems on
+// the grid broadphase. A projectile stops on the first solid tile and is
+// fired again every REFIRE ticks; sensors it flies through pass it on.
+// move_axis_pixels() sweeps to the next pixel it has to answer, so the
+// cost per tick should barely move with speed.
+
+#include "bench.h"
+#include "game/collision/broadphase.h"
+#include "game/collision/collision.h"
+#include "game/systems/ecs_systems.h"
+
+#include <math.h>
+
+#define MOVERS   2000
+#define SENSORS  200
+#define TILE     16
+#define TILES    120 // per axis
+#define SIDE     (TILES * TILE)
+#define TICKS    300
+#define REFIRE   10
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena      g_arena;
+static Arena      g_scratch;
+static World      g_world;
+static Broadphase g_broadphase;
+static uint8_t    g_solid[TILES * TILES];
+static EntityId   g_ids  [MOVERS];
+
+static void populate(uint32_t *state) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    world_init(&g_world, &g_arena, WORLD_STORAGE_SPARSE);
+    g_scratch = arena_sub(&g_arena, SCRATCH_ARENA_BYTES, ARENA_TAG_SCRATCH);
+    broadphase_init(&g_broadphase, &g_arena, BROADPHASE_GRID, MOVERS + SENSORS + 1);
+    g_world.broadphase = &g_broadphase;
+
+    for (int i = 0; i < TILES * TILES; i++) g_solid[i] = (bench_xorshift(state) % 24) == 0;
+    Prefab map = (Prefab){
+        .components = COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER),
+        .collider   = collider_grid(TILE, TILES, TILES, collide_grid_alloc(&g_arena, TILES, TILES, true, ARENA_TAG_COLLISION),
+                                    true, COL_SOLID, COL_NONE),
+    };
+    collide_grid_pack(&map.collider.shape.as.grid, g_solid);
+    world_spawn_batch(&g_world, &map, 1, g_ids);
+
+    const Prefab sensor = (Prefab){
+        .components = COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER),
+        .collider   = collider_rect((Vector2){ 0, 0 }, (Vector2){ 32, 32 }, COL_SENSOR, COL_NONE),
+    };
+    world_spawn_batch(&g_world, &sensor, SENSORS, g_ids);
+    for (int i = 0; i < SENSORS; i++) {
+        *world_get_position(&g_world, g_ids[i]) = (Position){
+            (float)(bench_xorshift(state) % (SIDE - 32)), (float)(bench_xorshift(state) % (SIDE - 32)) };
+    }
+
+    const Prefab mover = (Prefab){
+        .components      = COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY) |
+                           COMPONENT_BIT(COMPONENT_COLLIDER) | COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER),
+        .collider        = collider_rect((Vector2){ 0, 0 }, (Vector2){ 4, 4 }, COL_NONE, COL_SOLID | COL_SENSOR),
+        .move_platformer = { MOVE_PLATFORMER_DEFAULTS },
+    };
+    world_spawn_batch(&g_world, &mover, MOVERS, g_ids);
+    for (int i = 0; i < MOVERS; i++) {
+        *world_get_position(&g_world, g_ids[i]) = (Position){
+            (float)(bench_xorshift(state) % (SIDE - 4)), (float)(bench_xorshift(state) % (SIDE - 4)) };
+    }
+}
+
+static void fire(uint32_t *state, const float speed) {
+    for (int i = 0; i < MOVERS; i++) {
+        const float angle = (float)(bench_xorshift(state) % 3600) * (6.2831853f / 3600.0f);
+        world_get_velocity(&g_world, g_ids[i])->value = (Vector2){ cosf(angle) * speed, sinf(angle) * speed };
+    }
+}
+
+static void tick(uint32_t *state, const int index, const float speed) {
+    const Bounds bounds = { 0, 0, SIDE, SIDE };
+    if (index % REFIRE == 0) fire(state, speed);
+    broadphase_update(&g_broadphase, &g_world);
+    sys_move_platformer (&g_world, &g_scratch, 1.0f / 60.0f);
+    sys_bounce_in_bounds(&g_world, bounds);
+}
+
+int main(void) {
+    printf("%d projectiles over a %dx%d tilemap, %d sensors, ms per tick\n", MOVERS, TILES, TILES, SENSORS);
+    printf("%10s %10s %12s\n", "px/s", "px/tick", "ms/tick");
+    const float speeds[] = { 300.0f, 1200.0f, 4800.0f, 19200.0f };
+    for (int s = 0; s < (int)(sizeof speeds / sizeof speeds[0]); s++) {
+        uint32_t state = 0x2545F491u;
+        populate(&state);
+        int    index = 0;
+        double ns;
+        BENCH_NS_PER_ITER(ns, TICKS, tick(&state, index++, speeds[s]));
+        printf("%10.0f %10.0f %12.3f\n", speeds[s], speeds[s] / 60.0f, ns / 1e6);
+        bench_sink += (uint64_t)world_get_position(&g_world, g_ids[0])->x;
+    }
+    return 0;
+}
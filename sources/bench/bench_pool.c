@@ -0,0 +1,124 @@
+// Spawn/despawn churn: LIVE objects the size of a collision event record,
+// of which CHURN are freed and replaced every round, as entities come and go.
+// Compares the Pool free list against arena_alloc() that never frees (what
+// entity side data did before) and against malloc/free. Each new object is
+// written once, so first-touch cost is part of every column.
+
+#include "bench.h"
+#include "shared/arena.h"
+#include "shared/pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LIVE   8192
+#define CHURN  1024
+#define ROUNDS 500
+
+typedef struct {
+    uint64_t a, b;
+    float    normal[2];
+    float    depth;
+    uint32_t flags;
+    uint8_t  pad[32];
+} EventRecord;
+
+_Static_assert(sizeof(EventRecord) == 64, "one cache line per record");
+
+static _Alignas(ARENA_BASE_ALIGN) uint8_t g_arena_bytes[ARENA_BYTES];
+static Arena        g_arena;
+static Pool         g_pool;
+static EventRecord *g_live[LIVE];
+static uint32_t     g_victims[ROUNDS][CHURN];
+
+static void fill(EventRecord *record, const uint32_t i) {
+    record->a     = i;
+    record->b     = (uint64_t)i * 31;
+    record->flags = i;
+}
+
+// Same victims for every allocator, so the free patterns match.
+static void pick_victims(void) {
+    uint32_t state = 0x9E3779B9u;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < CHURN; i++) {
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            g_victims[round][i] = state % LIVE;
+        }
+    }
+}
+
+static uint64_t sum_live(void) {
+    uint64_t sum = 0;
+    for (int i = 0; i < LIVE; i++) sum += g_live[i]->a;
+    return sum;
+}
+
+static double churn_pool(void) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    POOL_INIT(&g_pool, &g_arena, EventRecord, ARENA_TAG_UNTAGGED);
+    for (uint32_t i = 0; i < LIVE; i++) fill(g_live[i] = POOL_NEW(&g_pool, EventRecord), i);
+
+    const uint64_t start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < CHURN; i++) {
+            const uint32_t victim = g_victims[round][i];
+            pool_free(&g_pool, g_live[victim]);
+            fill(g_live[victim] = POOL_NEW(&g_pool, EventRecord), victim);
+        }
+    }
+    const double ns = (double)(bench_now_ns() - start) / ((double)ROUNDS * CHURN);
+    bench_sink += sum_live();
+    return ns;
+}
+
+static double churn_arena(void) {
+    arena_init(&g_arena, g_arena_bytes, sizeof g_arena_bytes);
+    for (uint32_t i = 0; i < LIVE; i++) fill(g_live[i] = ARENA_NEW_ARRAY(&g_arena, EventRecord, 1, ARENA_TAG_UNTAGGED), i);
+
+    const uint64_t start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < CHURN; i++) {
+            const uint32_t victim = g_victims[round][i];
+            fill(g_live[victim] = ARENA_NEW_ARRAY(&g_arena, EventRecord, 1, ARENA_TAG_UNTAGGED), victim);
+        }
+    }
+    const double ns = (double)(bench_now_ns() - start) / ((double)ROUNDS * CHURN);
+    bench_sink += sum_live();
+    return ns;
+}
+
+static double churn_malloc(void) {
+    for (uint32_t i = 0; i < LIVE; i++) fill(g_live[i] = malloc(sizeof(EventRecord)), i);
+
+    const uint64_t start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < CHURN; i++) {
+            const uint32_t victim = g_victims[round][i];
+            free(g_live[victim]);
+            fill(g_live[victim] = malloc(sizeof(EventRecord)), victim);
+        }
+    }
+    const double ns = (double)(bench_now_ns() - start) / ((double)ROUNDS * CHURN);
+    bench_sink += sum_live();
+    for (int i = 0; i < LIVE; i++) free(g_live[i]);
+    return ns;
+}
+
+int main(void) {
+    pick_victims();
+    printf("live: %d x %zu B, churn: %d per round, rounds: %d, pool debug: %d\n",
+        LIVE, sizeof(EventRecord), CHURN, ROUNDS, POOL_DEBUG);
+    printf("%-20s %12s %14s\n", "allocator", "ns/replace", "arena bytes");
+
+    const double pool_ns = churn_pool();
+    const size_t pool_bytes = g_arena.used;
+    const double arena_ns = churn_arena();
+    const size_t arena_bytes = g_arena.used;
+    const double malloc_ns = churn_malloc();
+
+    printf("%-20s %12.1f %14zu\n", "pool",               pool_ns,   pool_bytes);
+    printf("%-20s %12.1f %14zu\n", "arena, never freed", arena_ns,  arena_bytes);
+    printf("%-20s %12.1f %14s\n",  "malloc/free",        malloc_ns, "-");
+    return 0;
+}
@@ -0,0 +1,380 @@
+#include "aabb_tree.h"
+
+#include <math.h>
+
+// ----------------------------------------------------------------------------
+// Boxes
+// ----------------------------------------------------------------------------
+
+Aabb aabb_from_rect(const Rectangle rect) {
+    return (Aabb){
+        fminf(rect.x, rect.x + rect.width),  fminf(rect.y, rect.y + rect.height),
+        fmaxf(rect.x, rect.x + rect.width),  fmaxf(rect.y, rect.y + rect.height),
+    };
+}
+
+static Aabb aabb_union(const Aabb a, const Aabb b) {
+    return (Aabb){ fminf(a.min_x, b.min_x), fminf(a.min_y, b.min_y), fmaxf(a.max_x, b.max_x), fmaxf(a.max_y, b.max_y) };
+}
+
+static float aabb_perimeter(const Aabb box) {
+    return 2.0f * ((box.max_x - box.min_x) + (box.max_y - box.min_y));
+}
+
+static bool aabb_contains(const Aabb outer, const Aabb inner) {
+    return outer.min_x <= inner.min_x && outer.min_y <= inner.min_y && inner.max_x <= outer.max_x && inner.max_y <= outer.max_y;
+}
+
+// Inclusive, so boxes that only touch still count: queries must stay a superset.
+static bool aabb_overlaps(const Aabb a, const Aabb b) {
+    return a.min_x <= b.max_x && b.min_x <= a.max_x && a.min_y <= b.max_y && b.min_y <= a.max_y;
+}
+
+// Slab test of the segment [from, from + delta] against the box, edges included.
+static bool aabb_segment_overlaps(const Aabb box, const Vector2 from, const Vector2 delta) {
+    float t_min = 0.0f, t_max = 1.0f;
+    const float origin[2] = { from.x,    from.y    };
+    const float dir   [2] = { delta.x,   delta.y   };
+    const float lo    [2] = { box.min_x, box.min_y };
+    const float hi    [2] = { box.max_x, box.max_y };
+    for (int axis = 0; axis < 2; axis++) {
+        if (dir[axis] == 0.0f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        const float inv = 1.0f / dir[axis];
+        float t_lo = (lo[axis] - origin[axis]) * inv;
+        float t_hi = (hi[axis] - origin[axis]) * inv;
+        if (t_lo > t_hi) { const float swap = t_lo; t_lo = t_hi; t_hi = swap; }
+        if (t_lo > t_min) t_min = t_lo;
+        if (t_hi < t_max) t_max = t_hi;
+        if (t_min > t_max) return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Nodes
+// ----------------------------------------------------------------------------
+
+#define NODE(tree, index) (&(tree)->nodes.items[(index)])
+
+static bool is_leaf(const AabbNode *node) { return node->child_a == AABB_TREE_NONE; }
+
+// Index of a fresh node, AABB_TREE_NONE when the arena is full. May move
+// the node array: refetch node pointers after calling.
+static uint32_t alloc_node(AabbTree *tree) {
+    uint32_t index = tree->free_node;
+    if (index != AABB_TREE_NONE) {
+        tree->free_node = NODE(tree, index)->parent;
+    } else {
+        if (!ARRAY_RESERVE(&tree->nodes, tree->nodes.count + 1)) return AABB_TREE_NONE;
+        index = tree->nodes.count++;
+    }
+    *NODE(tree, index) = (AabbNode){
+        .parent  = AABB_TREE_NONE,
+        .child_a = AABB_TREE_NONE,
+        .child_b = AABB_TREE_NONE,
+        .entity  = ENTITY_NONE,
+    };
+    return index;
+}
+
+static void free_node(AabbTree *tree, const uint32_t index) {
+    AabbNode *node = NODE(tree, index);
+    node->height    = -1;
+    node->entity    = ENTITY_NONE;
+    node->parent    = tree->free_node;
+    tree->free_node = index;
+}
+
+static void replace_child(AabbTree *tree, const uint32_t parent, const uint32_t old_child, const uint32_t new_child) {
+    if (parent == AABB_TREE_NONE) { tree->root = new_child; return; }
+    AabbNode *node = NODE(tree, parent);
+    if (node->child_a == old_child) node->child_a = new_child;
+    else                            node->child_b = new_child;
+}
+
+static int32_t max_i32(const int32_t a, const int32_t b) { return a > b ? a : b; }
+
+// Swaps `index`'s child `child` with `grandchild`, a child of its other
+// child `parent`. `index`'s own box doesn't change; `parent`'s is refitted.
+static void swap_down(AabbTree *tree, const uint32_t index, const uint32_t child, const uint32_t parent, const uint32_t grandchild) {
+    AabbNode *node = NODE(tree, index);
+    if (node->child_a == child) node->child_a = grandchild;
+    else                        node->child_b = grandchild;
+    NODE(tree, grandchild)->parent = index;
+
+    AabbNode *parent_node = NODE(tree, parent);
+    if (parent_node->child_a == grandchild) parent_node->child_a = child;
+    else                                    parent_node->child_b = child;
+    NODE(tree, child)->parent = parent;
+
+    const AabbNode *a = NODE(tree, parent_node->child_a);
+    const AabbNode *b = NODE(tree, parent_node->child_b);
+    parent_node->box    = aabb_union(a->box, b->box);
+    parent_node->height = 1 + max_i32(a->height, b->height);
+    node->height        = 1 + max_i32(NODE(tree, node->child_a)->height, NODE(tree, node->child_b)->height);
+}
+
+// Tree rotation by the surface area heuristic rather than by height: swaps
+// a child of `index` with a grandchild on the other side when that shrinks
+// the child boxes the most, and leaves the node alone when nothing would.
+// Height-only rotations pair up subtrees that are nowhere near each other
+// and let the tree rot as colliders move; these keep it tight instead,
+// which matters more to queries than a perfect balance.
+static void rotate(AabbTree *tree, const uint32_t index) {
+    const AabbNode *node = NODE(tree, index);
+    if (node->height < 2) return;
+
+    const uint32_t index_b = node->child_a;
+    const uint32_t index_c = node->child_b;
+
+    // Candidates: `child` swaps with `grandchild` under `parent`, whose box
+    // becomes the union of `child` and the grandchild that stays.
+    uint32_t best_child = AABB_TREE_NONE, best_parent = AABB_TREE_NONE, best_grandchild = AABB_TREE_NONE;
+    float    best_gain  = 0.0f;
+    const uint32_t sides[2][2] = { { index_b, index_c }, { index_c, index_b } };
+    for (int side = 0; side < 2; side++) {
+        const uint32_t  child  = sides[side][0];
+        const uint32_t  parent = sides[side][1];
+        const AabbNode *parent_node = NODE(tree, parent);
+        if (is_leaf(parent_node)) continue;
+
+        const float    before        = aabb_perimeter(parent_node->box);
+        const uint32_t grandchild[2] = { parent_node->child_a, parent_node->child_b };
+        for (int i = 0; i < 2; i++) {
+            const Aabb  stays = NODE(tree, grandchild[1 - i])->box;
+            const float gain  = before - aabb_perimeter(aabb_union(NODE(tree, child)->box, stays));
+            if (gain > best_gain) {
+                best_gain       = gain;
+                best_child      = child;
+                best_parent     = parent;
+                best_grandchild = grandchild[i];
+            }
+        }
+    }
+    if (best_child != AABB_TREE_NONE) swap_down(tree, index, best_child, best_parent, best_grandchild);
+}
+
+// Refits and rotates every node from `index` up to the root.
+static void refit_upwards(AabbTree *tree, uint32_t index) {
+    while (index != AABB_TREE_NONE) {
+        AabbNode       *node = NODE(tree, index);
+        const AabbNode *a    = NODE(tree, node->child_a);
+        const AabbNode *b    = NODE(tree, node->child_b);
+        node->height = 1 + max_i32(a->height, b->height);
+        node->box    = aabb_union(a->box, b->box);
+        rotate(tree, index);
+        index = node->parent;
+    }
+}
+
+// The sibling to pair a new leaf with, minimising the new parent's perimeter
+// plus what every ancestor grows by (the surface area heuristic, perimeter
+// for area in 2D). Branch and bound: a subtree is only entered while the
+// cheapest sibling it could hold still beats the best one found. Costing
+// the new parent's whole box, not just the growth, is what keeps a
+// level-sized leaf from pulling every insertion into its subtree.
+static uint32_t pick_sibling(const AabbTree *tree, const Aabb leaf_box) {
+    const float leaf_perimeter = aabb_perimeter(leaf_box);
+    uint32_t index     = tree->root;
+    uint32_t best      = index;
+    float    best_cost = aabb_perimeter(aabb_union(NODE(tree, index)->box, leaf_box));
+    float    inherited = 0.0f; // what the ancestors of `index` grow by
+
+    while (!is_leaf(NODE(tree, index))) {
+        const AabbNode *node = NODE(tree, index);
+        const float cost_here = aabb_perimeter(aabb_union(node->box, leaf_box));
+        if (cost_here + inherited < best_cost) { best = index; best_cost = cost_here + inherited; }
+        inherited += cost_here - aabb_perimeter(node->box);
+
+        const uint32_t children[2] = { node->child_a, node->child_b };
+        float lower[2];
+        for (int i = 0; i < 2; i++) {
+            const AabbNode *child  = NODE(tree, children[i]);
+            const float     direct = aabb_perimeter(aabb_union(child->box, leaf_box)) + inherited;
+            if (is_leaf(child)) {
+                if (direct < best_cost) { best = children[i]; best_cost = direct; }
+                lower[i] = INFINITY;
+            } else {
+                // Deeper down the new parent is at least the leaf itself, and
+                // this child grows by at least nothing.
+                lower[i] = direct + fminf(leaf_perimeter - aabb_perimeter(child->box), 0.0f);
+            }
+        }
+
+        if (best_cost <= lower[0] && best_cost <= lower[1]) break;
+        index = lower[0] <= lower[1] ? children[0] : children[1];
+    }
+    return best;
+}
+
+static bool insert_leaf(AabbTree *tree, const uint32_t leaf) {
+    if (tree->root == AABB_TREE_NONE) {
+        tree->root = leaf;
+        NODE(tree, leaf)->parent = AABB_TREE_NONE;
+        return true;
+    }
+
+    const uint32_t sibling    = pick_sibling(tree, NODE(tree, leaf)->box);
+    const uint32_t new_parent = alloc_node(tree);
+    if (new_parent == AABB_TREE_NONE) return false;
+
+    AabbNode *parent_node  = NODE(tree, new_parent);
+    AabbNode *sibling_node = NODE(tree, sibling);
+    AabbNode *leaf_node    = NODE(tree, leaf);
+    const uint32_t old_parent = sibling_node->parent;
+    parent_node->parent  = old_parent;
+    parent_node->box     = aabb_union(leaf_node->box, sibling_node->box);
+    parent_node->height  = sibling_node->height + 1;
+    parent_node->child_a = sibling;
+    parent_node->child_b = leaf;
+    sibling_node->parent = new_parent;
+    leaf_node->parent    = new_parent;
+    replace_child(tree, old_parent, sibling, new_parent);
+
+    refit_upwards(tree, new_parent);
+    return true;
+}
+
+static void remove_leaf(AabbTree *tree, const uint32_t leaf) {
+    if (leaf == tree->root) {
+        tree->root = AABB_TREE_NONE;
+        return;
+    }
+
+    const uint32_t  parent       = NODE(tree, leaf)->parent;
+    const AabbNode *parent_node  = NODE(tree, parent);
+    const uint32_t  grand_parent = parent_node->parent;
+    const uint32_t  sibling      = parent_node->child_a == leaf ? parent_node->child_b : parent_node->child_a;
+
+    // The sibling takes the parent's place.
+    replace_child(tree, grand_parent, parent, sibling);
+    NODE(tree, sibling)->parent = grand_parent;
+    free_node(tree, parent);
+    refit_upwards(tree, grand_parent);
+}
+
+// ----------------------------------------------------------------------------
+// Tree
+// ----------------------------------------------------------------------------
+
+void aabb_tree_init(AabbTree *tree, Arena *arena, const uint32_t expected, const ArenaTag tag) {
+    *tree = (AabbTree){ .root = AABB_TREE_NONE, .free_node = AABB_TREE_NONE };
+    // A tree over n leaves has n - 1 inner nodes.
+    ARRAY_INIT(&tree->nodes, arena, expected * 2, tag);
+    hash_map_init(&tree->leaves, arena, expected, tag);
+}
+
+void aabb_tree_clear(AabbTree *tree) {
+    ARRAY_CLEAR(&tree->nodes);
+    hash_map_clear(&tree->leaves);
+    tree->root      = AABB_TREE_NONE;
+    tree->free_node = AABB_TREE_NONE;
+}
+
+bool aabb_tree_set(AabbTree *tree, const EntityId entity, const Aabb box) {
+    uint32_t leaf;
+    if (hash_map_get(&tree->leaves, entity, &leaf)) {
+        AabbNode *node = NODE(tree, leaf);
+        node->stamp = tree->stamp;
+        if (aabb_contains(node->box, box)) return true;
+        remove_leaf(tree, leaf);
+    } else {
+        leaf = alloc_node(tree);
+        if (leaf == AABB_TREE_NONE) return false;
+        if (!hash_map_put(&tree->leaves, entity, leaf)) { free_node(tree, leaf); return false; }
+    }
+
+    AabbNode *node = NODE(tree, leaf);
+    node->entity = entity;
+    node->stamp  = tree->stamp;
+    node->box    = (Aabb){
+        box.min_x - AABB_TREE_MARGIN, box.min_y - AABB_TREE_MARGIN,
+        box.max_x + AABB_TREE_MARGIN, box.max_y + AABB_TREE_MARGIN,
+    };
+    if (insert_leaf(tree, leaf)) return true;
+
+    // No room for its parent: drop the leaf rather than leave it half-linked.
+    hash_map_remove(&tree->leaves, entity);
+    free_node(tree, leaf);
+    return false;
+}
+
+void aabb_tree_remove(AabbTree *tree, const EntityId entity) {
+    uint32_t leaf;
+    if (!hash_map_get(&tree->leaves, entity, &leaf)) return;
+    hash_map_remove(&tree->leaves, entity);
+    remove_leaf(tree, leaf);
+    free_node(tree, leaf);
+}
+
+void aabb_tree_begin_sync(AabbTree *tree) {
+    tree->stamp++;
+}
+
+void aabb_tree_end_sync(AabbTree *tree) {
+    // Removing a leaf frees its parent too, possibly one further along:
+    // free nodes have height -1 and are skipped.
+    for (uint32_t index = 0; index < tree->nodes.count; index++) {
+        const AabbNode *node = NODE(tree, index);
+        if (node->height != 0 || node->stamp == tree->stamp) continue;
+        aabb_tree_remove(tree, node->entity);
+    }
+}
+
+int32_t aabb_tree_height(const AabbTree *tree) {
+    return tree->root == AABB_TREE_NONE ? 0 : NODE(tree, tree->root)->height;
+}
+
+// ----------------------------------------------------------------------------
+// Queries
+// ----------------------------------------------------------------------------
+
+AabbTreeIter aabb_tree_iter_box(const AabbTree *tree, const Aabb box) {
+    return (AabbTreeIter){ .tree = tree, .node = tree->root, .box = box };
+}
+
+AabbTreeIter aabb_tree_iter_segment(const AabbTree *tree, const Vector2 from, const Vector2 to) {
+    return (AabbTreeIter){
+        .tree    = tree,
+        .node    = tree->root,
+        .box     = { fminf(from.x, to.x), fminf(from.y, to.y), fmaxf(from.x, to.x), fmaxf(from.y, to.y) },
+        .segment = true,
+        .from    = from,
+        .delta   = (Vector2){ to.x - from.x, to.y - from.y },
+    };
+}
+
+// The node a depth-first walk visits after `index`'s subtree: climb while
+// coming back from a second child, then step over to the first sibling on
+// the right. Parent links make the walk stackless, so no depth limit.
+static uint32_t next_after(const AabbTree *tree, uint32_t index) {
+    uint32_t parent = NODE(tree, index)->parent;
+    while (parent != AABB_TREE_NONE && NODE(tree, parent)->child_b == index) {
+        index  = parent;
+        parent = NODE(tree, index)->parent;
+    }
+    return parent == AABB_TREE_NONE ? AABB_TREE_NONE : NODE(tree, parent)->child_b;
+}
+
+bool aabb_tree_iter_next(AabbTreeIter *it, EntityId *out_entity) {
+    const AabbTree *tree = it->tree;
+    while (it->node != AABB_TREE_NONE) {
+        const uint32_t  index = it->node;
+        const AabbNode *node  = NODE(tree, index);
+        const bool touches = aabb_overlaps(node->box, it->box) &&
+                             (!it->segment || aabb_segment_overlaps(node->box, it->from, it->delta));
+        if (touches && !is_leaf(node)) {
+            it->node = node->child_a;
+            continue;
+        }
+        it->node = next_after(tree, index);
+        if (touches) {
+            *out_entity = node->entity;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,88 @@
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include "shared/arena.h"
+#include "shared/array.h"
+#include "shared/ecs_world.h"
+#include "shared/hash_map.h"
+#include "raylib.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Dynamic AABB tree over collider boxes: one leaf per entity, every inner
+// node bounding its two children.
+//
+// Leaves store a "fat" box, the collider's box grown by AABB_TREE_MARGIN on
+// every side, so a collider that moves a little stays inside it and the tree
+// isn't touched; only one that leaves its fat box is taken out and inserted
+// again. Insertion looks for the sibling that adds the least box perimeter
+// to the tree (the surface area heuristic, with perimeter standing in for
+// area in 2D), and every node on the way back up is rotated by the same
+// cost, which keeps the tree tight as colliders move around in it.
+//
+// Unlike a uniform grid it doesn't care how sizes mix: a level-sized tilemap
+// is one leaf near the root, projectiles are leaves deep down, and a query
+// only descends into boxes it touches.
+//
+// Nodes live in one arena array and refer to each other by index, so the
+// array may move as it grows. Not thread-safe.
+#define AABB_TREE_MARGIN 4.0f // px
+#define AABB_TREE_NONE   UINT32_MAX
+
+typedef struct {
+    float min_x, min_y, max_x, max_y;
+} Aabb;
+
+typedef struct {
+    Aabb     box;              // fat for leaves, the union of the children otherwise
+    uint32_t parent;           // AABB_TREE_NONE at the root; next free node while on the free list
+    uint32_t child_a, child_b; // AABB_TREE_NONE for leaves
+    int32_t  height;           // 0 for leaves, -1 while free
+    EntityId entity;           // leaves only
+    uint32_t stamp;            // leaves only: the last aabb_tree_begin_sync() that touched them
+} AabbNode;
+
+typedef struct {
+    ARRAY(AabbNode) nodes;
+    uint32_t        root;
+    uint32_t        free_node;
+    HashMap         leaves;    // entity -> leaf node
+    uint32_t        stamp;     // current sync
+} AabbTree;
+
+Aabb aabb_from_rect(Rectangle rect);
+
+void aabb_tree_init (AabbTree *tree, Arena *arena, uint32_t expected, ArenaTag tag);
+void aabb_tree_clear(AabbTree *tree);
+
+// Inserts `entity` or, if it has a leaf, moves it: the leaf is only
+// reinserted when `box` has left its fat box. False when the arena is full,
+// with the tree still consistent but the entity possibly missing from it.
+bool aabb_tree_set   (AabbTree *tree, EntityId entity, Aabb box);
+void aabb_tree_remove(AabbTree *tree, EntityId entity);
+
+// Mark and sweep against the world: begin, aabb_tree_set() every live entity,
+// end. End removes every leaf the sets since begin didn't touch.
+void aabb_tree_begin_sync(AabbTree *tree);
+void aabb_tree_end_sync  (AabbTree *tree);
+
+// Leaves whose fat box touches the box, or the segment [from, from + delta],
+// each once, in no particular order. Fat boxes make it a superset of the
+// colliders actually touching; the caller runs the exact test.
+typedef struct {
+    const AabbTree *tree;
+    uint32_t        node;    // next node to test
+    Aabb            box;     // query box; for segments, the segment's bounds
+    bool            segment;
+    Vector2         from, delta;
+} AabbTreeIter;
+
+AabbTreeIter aabb_tree_iter_box    (const AabbTree *tree, Aabb box);
+AabbTreeIter aabb_tree_iter_segment(const AabbTree *tree, Vector2 from, Vector2 to);
+bool         aabb_tree_iter_next   (AabbTreeIter *it, EntityId *out_entity);
+
+// Tallest path from the root, for reports; 0 for a single leaf or an empty tree.
+int32_t aabb_tree_height(const AabbTree *tree);
+
+#endif //AABB_TREE_H
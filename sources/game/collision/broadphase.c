@@ -0,0 +1,266 @@
+#include "broadphase.h"
+#include "collision.h"
+#include "shared/hash_map.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef struct {
+    int16_t min_x, min_y, max_x, max_y;
+} CellRange;
+
+// Cell coordinates are clamped to int16_t: everything past ±2M px shares
+// the edge cells, which only costs precision out there, never a missed pair.
+static int16_t cell_of(const float coord) {
+    float cell = floorf(coord * (1.0f / BROADPHASE_CELL_SIZE));
+    if (!(cell >= (float)INT16_MIN)) cell = (float)INT16_MIN; // NaN included
+    if (cell > (float)INT16_MAX)     cell = (float)INT16_MAX;
+    return (int16_t)cell;
+}
+
+static CellRange cells_of(const Rectangle box) {
+    const float left   = fminf(box.x, box.x + box.width);
+    const float right  = fmaxf(box.x, box.x + box.width);
+    const float top    = fminf(box.y, box.y + box.height);
+    const float bottom = fmaxf(box.y, box.y + box.height);
+    return (CellRange){ cell_of(left), cell_of(top), cell_of(right), cell_of(bottom) };
+}
+
+static int32_t cell_count(const CellRange range) {
+    return ((int32_t)range.max_x - range.min_x + 1) * ((int32_t)range.max_y - range.min_y + 1);
+}
+
+static bool same_cells(const CellRange a, const CellRange b) {
+    return a.min_x == b.min_x && a.min_y == b.min_y && a.max_x == b.max_x && a.max_y == b.max_y;
+}
+
+static uint32_t bucket_of(const Broadphase *broadphase, const int32_t cell_x, const int32_t cell_y) {
+    const uint64_t key = (uint64_t)(uint16_t)cell_x << 16 | (uint16_t)cell_y;
+    return (uint32_t)hash_u64(key) & (broadphase->num_buckets - 1);
+}
+
+static bool grow_buckets(Broadphase *broadphase, const uint32_t colliders) {
+    uint32_t num_buckets = broadphase->num_buckets ? broadphase->num_buckets : BROADPHASE_MIN_BUCKETS;
+    while (num_buckets < colliders * 2) num_buckets *= 2;
+    if (num_buckets == broadphase->num_buckets) return true;
+
+    uint32_t *buckets = ARENA_NEW_ARRAY(broadphase->arena, uint32_t, num_buckets, ARENA_TAG_COLLISION);
+    if (!buckets) return false;
+    broadphase->buckets     = buckets;
+    broadphase->num_buckets = num_buckets;
+    return true;
+}
+
+void broadphase_init(Broadphase *broadphase, Arena *arena, const BroadphaseKind kind, const uint32_t expected) {
+    *broadphase = (Broadphase){ .kind = kind, .arena = arena, .free_entry = BROADPHASE_NONE };
+    if (kind == BROADPHASE_TREE) {
+        aabb_tree_init(&broadphase->tree, arena, expected, ARENA_TAG_COLLISION);
+        return;
+    }
+    ARRAY_INIT(&broadphase->entries, arena, expected, ARENA_TAG_COLLISION);
+    ARRAY_INIT(&broadphase->large,   arena, 0,        ARENA_TAG_COLLISION);
+    (void)grow_buckets(broadphase, expected);
+}
+
+// ----------------------------------------------------------------------------
+// Grid filing
+// ----------------------------------------------------------------------------
+
+static bool insert(Broadphase *broadphase, const EntityId entity, const CellRange range) {
+    if (cell_count(range) > BROADPHASE_MAX_CELLS) return ARRAY_PUSH(&broadphase->large, entity);
+
+    for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+        for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+            uint32_t index = broadphase->free_entry;
+            if (index != BROADPHASE_NONE) {
+                broadphase->free_entry = broadphase->entries.items[index].next;
+            } else {
+                if (!ARRAY_RESERVE(&broadphase->entries, broadphase->entries.count + 1)) return false;
+                index = broadphase->entries.count++;
+            }
+
+            uint32_t *head = &broadphase->buckets[bucket_of(broadphase, cell_x, cell_y)];
+            broadphase->entries.items[index] = (BroadphaseEntry){
+                .entity  = entity,
+                .cell_x  = (int16_t)cell_x, .cell_y  = (int16_t)cell_y,
+                .first_x = range.min_x,     .first_y = range.min_y,
+                .next    = *head,
+            };
+            *head = index;
+        }
+    }
+    return true;
+}
+
+static void remove_entity(Broadphase *broadphase, const EntityId entity, const CellRange range) {
+    if (cell_count(range) > BROADPHASE_MAX_CELLS) {
+        for (uint32_t i = 0; i < broadphase->large.count; i++) {
+            if (broadphase->large.items[i] == entity) { ARRAY_REMOVE_SWAP(&broadphase->large, i); break; }
+        }
+        return;
+    }
+
+    for (int32_t cell_y = range.min_y; cell_y <= range.max_y; cell_y++) {
+        for (int32_t cell_x = range.min_x; cell_x <= range.max_x; cell_x++) {
+            uint32_t *link = &broadphase->buckets[bucket_of(broadphase, cell_x, cell_y)];
+            while (*link != BROADPHASE_NONE) {
+                BroadphaseEntry *entry = &broadphase->entries.items[*link];
+                if (entry->entity == entity && entry->cell_x == cell_x && entry->cell_y == cell_y) {
+                    const uint32_t index = *link;
+                    *link                  = entry->next;
+                    entry->entity          = ENTITY_NONE;
+                    entry->next            = broadphase->free_entry;
+                    broadphase->free_entry = index;
+                    break;
+                }
+                link = &entry->next;
+            }
+        }
+    }
+}
+
+static bool update_grid(Broadphase *broadphase, World *world, const QueryId query) {
+    const uint32_t colliders = world_query_count(world, query);
+    if (!grow_buckets(broadphase, colliders)) return false;
+    memset(broadphase->buckets, 0xFF, sizeof(uint32_t) * broadphase->num_buckets); // BROADPHASE_NONE
+    ARRAY_CLEAR(&broadphase->entries);
+    ARRAY_CLEAR(&broadphase->large);
+    broadphase->free_entry = BROADPHASE_NONE;
+    if (!ARRAY_RESERVE(&broadphase->entries, colliders)) return false;
+
+    WorldIter it = world_iter(world, query);
+    while (world_iter_next(&it)) {
+        const Position *pos = it.components[COMPONENT_POSITION];
+        const Collider *col = it.components[COMPONENT_COLLIDER];
+        if (!insert(broadphase, it.entity, cells_of(collide_shape_bounds(&col->shape, *pos)))) return false;
+    }
+    return true;
+}
+
+static bool update_tree(Broadphase *broadphase, World *world, const QueryId query) {
+    AabbTree *tree = &broadphase->tree;
+    // Something failed to fit last time: the tree may be missing leaves, start over.
+    if (!broadphase->valid) aabb_tree_clear(tree);
+
+    aabb_tree_begin_sync(tree);
+    WorldIter it = world_iter(world, query);
+    while (world_iter_next(&it)) {
+        const Position *pos = it.components[COMPONENT_POSITION];
+        const Collider *col = it.components[COMPONENT_COLLIDER];
+        if (!aabb_tree_set(tree, it.entity, aabb_from_rect(collide_shape_bounds(&col->shape, *pos)))) return false;
+    }
+    aabb_tree_end_sync(tree);
+    return true;
+}
+
+void broadphase_update(Broadphase *broadphase, World *world) {
+    const QueryId query = world_query_cached(world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER), 0);
+    broadphase->valid = (broadphase->kind == BROADPHASE_TREE) ? update_tree(broadphase, world, query)
+                                                              : update_grid(broadphase, world, query);
+}
+
+void broadphase_move(Broadphase *broadphase, const EntityId entity, const Collider *collider, const Vector2 from, const Vector2 to) {
+    if (!broadphase->valid) return;
+    // Half-filed is worse than unfiled: on failure, fall back to full scans until the next update.
+    if (broadphase->kind == BROADPHASE_TREE) {
+        const Aabb box = aabb_from_rect(collide_shape_bounds(&collider->shape, to));
+        if (!aabb_tree_set(&broadphase->tree, entity, box)) broadphase->valid = false;
+        return;
+    }
+
+    const CellRange old_range = cells_of(collide_shape_bounds(&collider->shape, from));
+    const CellRange new_range = cells_of(collide_shape_bounds(&collider->shape, to));
+    if (same_cells(old_range, new_range)) return;
+
+    remove_entity(broadphase, entity, old_range);
+    if (!insert(broadphase, entity, new_range)) broadphase->valid = false;
+}
+
+// ----------------------------------------------------------------------------
+// Queries
+// ----------------------------------------------------------------------------
+
+BroadphaseIter broadphase_iter(const Broadphase *broadphase, const Rectangle box) {
+    if (broadphase->kind == BROADPHASE_TREE) {
+        return (BroadphaseIter){
+            .broadphase = broadphase,
+            .tree       = aabb_tree_iter_box(&broadphase->tree, aabb_from_rect(box)),
+            .entity     = ENTITY_NONE,
+        };
+    }
+
+    const CellRange range = cells_of(box);
+    return (BroadphaseIter){
+        .broadphase = broadphase,
+        .min_x  = range.min_x, .min_y = range.min_y,
+        .max_x  = range.max_x, .max_y = range.max_y,
+        .cell_x = range.min_x - 1,
+        .cell_y = range.min_y,
+        .entry  = cell_count(range) > BROADPHASE_MAX_QUERY_CELLS ? 0 : BROADPHASE_NONE,
+        .scan   = cell_count(range) > BROADPHASE_MAX_QUERY_CELLS,
+        .entity = ENTITY_NONE,
+    };
+}
+
+BroadphaseIter broadphase_iter_point(const Broadphase *broadphase, const Vector2 point) {
+    return broadphase_iter(broadphase, (Rectangle){ point.x, point.y, 0.0f, 0.0f });
+}
+
+BroadphaseIter broadphase_iter_segment(const Broadphase *broadphase, const Vector2 from, const Vector2 to) {
+    if (broadphase->kind == BROADPHASE_TREE) {
+        return (BroadphaseIter){
+            .broadphase = broadphase,
+            .tree       = aabb_tree_iter_segment(&broadphase->tree, from, to),
+            .entity     = ENTITY_NONE,
+        };
+    }
+    return broadphase_iter(broadphase, (Rectangle){ from.x, from.y, to.x - from.x, to.y - from.y });
+}
+
+bool broadphase_iter_next(BroadphaseIter *it) {
+    const Broadphase *broadphase = it->broadphase;
+    if (broadphase->kind == BROADPHASE_TREE) return aabb_tree_iter_next(&it->tree, &it->entity);
+
+    if (it->large < broadphase->large.count) {
+        it->entity = broadphase->large.items[it->large++];
+        return true;
+    }
+
+    const BroadphaseEntry *entries = broadphase->entries.items;
+    if (it->scan) {
+        // Every filed entity has exactly one entry in its top-left cell.
+        while (it->entry < broadphase->entries.count) {
+            const BroadphaseEntry *entry = &entries[it->entry++];
+            if (entry->entity == ENTITY_NONE) continue;
+            if (entry->cell_x != entry->first_x || entry->cell_y != entry->first_y) continue;
+            it->entity = entry->entity;
+            return true;
+        }
+        return false;
+    }
+
+    for (;;) {
+        while (it->entry != BROADPHASE_NONE) {
+            const BroadphaseEntry *entry = &entries[it->entry];
+            it->entry = entry->next;
+            // Another cell hashed to the same bucket.
+            if (entry->cell_x != it->cell_x || entry->cell_y != it->cell_y) continue;
+            // An entity filed under several cells of the box is yielded from the
+            // top-left one of those only.
+            const int32_t first_x = entry->first_x > it->min_x ? entry->first_x : it->min_x;
+            const int32_t first_y = entry->first_y > it->min_y ? entry->first_y : it->min_y;
+            if (entry->cell_x != first_x || entry->cell_y != first_y) continue;
+            it->entity = entry->entity;
+            return true;
+        }
+
+        if (it->cell_x < it->max_x) {
+            it->cell_x++;
+        } else {
+            if (it->cell_y >= it->max_y) return false;
+            it->cell_x = it->min_x;
+            it->cell_y++;
+        }
+        it->entry = broadphase->buckets[bucket_of(broadphase, it->cell_x, it->cell_y)];
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "aabb_tree.h"
+#include "shared/array.h"
+#include "shared/ecs_world.h"
+#include "raylib.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Spatial index over collider bounding boxes, so a collision query only
+// looks at the entities near its box. Two backends behind one interface,
+// picked at broadphase_init():
+//
+//   GRID: uniform-grid spatial hash. Each collider is filed under every
+//         BROADPHASE_CELL_SIZE cell its box covers, one entry per cell,
+//         chained per bucket of a hashed cell table: the grid is unbounded
+//         and costs memory only where colliders are. A collider covering
+//         more than BROADPHASE_MAX_CELLS cells (a tilemap) goes on the
+//         `large` list instead, which every query walks. Refiled from
+//         scratch by every broadphase_update().
+//   TREE: dynamic AABB tree (aabb_tree.h). Indifferent to mixed collider
+//         sizes; broadphase_update() only touches the colliders that left
+//         their fat box, appeared or went away.
+//
+// broadphase_update() catches up with the world at the start of a tick;
+// real movers then keep their own entries current through broadphase_move()
+// (see move_step_pixels()), so each query sees the positions the movers
+// before it left behind, exactly as the full scan did. Entities created,
+// destroyed or moved by anything else show up at the next update.
+//
+// Plain data over an Arena, kept in GameMemory. Not thread-safe.
+typedef enum {
+    BROADPHASE_GRID = 0,
+    BROADPHASE_TREE,
+} BroadphaseKind;
+
+// GRID
+#define BROADPHASE_CELL_SIZE        64  // px, a few tiles; a power of two
+#define BROADPHASE_MAX_CELLS        16  // cells one collider is filed under before it goes on `large`
+#define BROADPHASE_MAX_QUERY_CELLS  256 // a query box covering more walks the entries instead
+#define BROADPHASE_MIN_BUCKETS      1024
+#define BROADPHASE_NONE             UINT32_MAX
+
+typedef struct {
+    EntityId entity;            // ENTITY_NONE while on the free list
+    int16_t  cell_x,  cell_y;   // the cell this entry files the entity under
+    int16_t  first_x, first_y;  // top-left cell of the entity's box
+    uint32_t next;              // next entry in the same bucket, or on the free list
+} BroadphaseEntry;
+
+struct Broadphase {
+    BroadphaseKind          kind;
+    bool                    valid;       // updated, and nothing has failed to fit since
+    Arena                  *arena;
+
+    // GRID
+    uint32_t               *buckets;     // first entry per hashed cell, BROADPHASE_NONE when empty
+    uint32_t                num_buckets; // a power of two, grown at update to twice the colliders
+    ARRAY(BroadphaseEntry)  entries;
+    uint32_t                free_entry;  // entries unlinked by broadphase_move(), reused first
+    ARRAY(EntityId)         large;       // colliders over BROADPHASE_MAX_CELLS cells
+
+    // TREE
+    AabbTree                tree;
+};
+
+void broadphase_init  (Broadphase *broadphase, Arena *arena, BroadphaseKind kind, uint32_t expected);
+// Catches up with every entity with a Position and a Collider.
+void broadphase_update(Broadphase *broadphase, World *world);
+// Refiles `entity` after it moved from `from` to `to`. Cheap when it stays
+// in its cells (GRID) or its fat box (TREE).
+void broadphase_move  (Broadphase *broadphase, EntityId entity, const Collider *collider, Vector2 from, Vector2 to);
+
+// Candidates near a box or a segment, each once, in no particular order:
+//
+//   BroadphaseIter it = broadphase_iter(broadphase, box);
+//   while (broadphase_iter_next(&it)) { narrowphase against it.entity ... }
+//
+// A superset of the colliders touching the box or the segment; the caller
+// runs the exact test. GRID answers a segment with the cells of its bounds,
+// TREE prunes every node against the segment itself.
+typedef struct {
+    const Broadphase *broadphase;
+    // GRID
+    int32_t  min_x, min_y, max_x, max_y; // cells the box covers
+    int32_t  cell_x, cell_y;             // cell being walked
+    uint32_t entry;                      // next entry to look at
+    uint32_t large;                      // next index into `large`
+    bool     scan;                       // box too big for cells: walk every entry instead
+    // TREE
+    AabbTreeIter tree;
+
+    EntityId entity;
+} BroadphaseIter;
+
+BroadphaseIter broadphase_iter        (const Broadphase *broadphase, Rectangle box);
+BroadphaseIter broadphase_iter_point  (const Broadphase *broadphase, Vector2 point);
+BroadphaseIter broadphase_iter_segment(const Broadphase *broadphase, Vector2 from, Vector2 to);
+bool           broadphase_iter_next   (BroadphaseIter *it);
+
+#endif //BROADPHASE_H
@@ -1,5 +1,8 @@
 #include "collision.h"
 
+#include <math.h>
+#include <string.h>
+
 CollisionContext collide_build_context(
     World          *world,
     const EntityId  mover,
@@ -35,6 +38,24 @@ static bool overlap_rect_rect(const ShapeRect *shape_a, const Vector2 pos_a, con
 
 static bool overlap_rect_circ(const ShapeRect *shape_a, const Vector2 pos_a, const ShapeCirc *shape_b, const Vector2 pos_b) { (void)shape_a;(void)pos_a;(void)shape_b,(void)pos_b; return false; }
 static bool overlap_rect_pill(const ShapeRect *shape_a, const Vector2 pos_a, const ShapePill *shape_b, const Vector2 pos_b) { (void)shape_a;(void)pos_a;(void)shape_b,(void)pos_b; return false; }
+
+// Any solid cell in columns [col_min, col_max] of one row of packed words:
+// a masked AND on the first and last word, a plain test on those between.
+static bool row_any(const uint64_t *row, const int col_min, const int col_max) {
+    const int      first = col_min >> 6;
+    const int      last  = col_max >> 6;
+    const uint64_t head  = ~0ull << (col_min & 63);
+    const uint64_t tail  = ~0ull >> (63 - (col_max & 63));
+    if (first == last) return (row[first] & head & tail) != 0;
+    if (row[first] & head) return true;
+    for (int word = first + 1; word < last; word++) {
+        if (row[word]) return true;
+    }
+    return (row[last] & tail) != 0;
+}
+
+static int grid_blocks(const int cells) { return (cells + GRID_BLOCK - 1) / GRID_BLOCK; }
+
 static bool overlap_rect_grid(const ShapeRect *shape_a, const Vector2 pos_a, const ShapeGrid *shape_b, const Vector2 pos_b) {
     // Mover rect in world space.
     const float rect_left   = pos_a.x + shape_a->offset.x;
@@ -47,28 +68,46 @@ static bool overlap_rect_grid(const ShapeRect *shape_a, const Vector2 pos_a, con
     const float grid_origin_y = pos_b.y + shape_b->offset.y;
     const int   cell          = shape_b->cell_size;
 
-    // Cell range (inclusive on both ends) that the rect can touch.
-    int col_min = (int)floorf((rect_left   - grid_origin_x) / (float)cell);
-    int col_max = (int)floorf((rect_right  - grid_origin_x) / (float)cell);
-    int row_min = (int)floorf((rect_top    - grid_origin_y) / (float)cell);
-    int row_max = (int)floorf((rect_bottom - grid_origin_y) / (float)cell);
+    // Cell range (inclusive on both ends) that the rect can touch. Truncation
+    // is floor for everything the clamps below keep; a rect edge just left of
+    // or above the grid rounds up to cell 0, which the trims take back off.
+    int col_min = (int)((rect_left   - grid_origin_x) / (float)cell);
+    int col_max = (int)((rect_right  - grid_origin_x) / (float)cell);
+    int row_min = (int)((rect_top    - grid_origin_y) / (float)cell);
+    int row_max = (int)((rect_bottom - grid_origin_y) / (float)cell);
 
     if (col_min < 0)              col_min = 0;
     if (row_min < 0)              row_min = 0;
     if (col_max >= shape_b->cols) col_max = shape_b->cols - 1;
     if (row_max >= shape_b->rows) row_max = shape_b->rows - 1;
+
+    // Down to the cells the rect overlaps rather than touches, by the same
+    // strict edge tests CheckCollisionRecs() makes against each cell rect.
+    // Only the end cells can fail them, an edge on a cell line at most.
+    col_min += !(rect_left   < grid_origin_x + (float)(col_min * cell) + (float)cell);
+    col_max -= !(rect_right  > grid_origin_x + (float)(col_max * cell));
+    row_min += !(rect_top    < grid_origin_y + (float)(row_min * cell) + (float)cell);
+    row_max -= !(rect_bottom > grid_origin_y + (float)(row_max * cell));
     if (col_min > col_max || row_min > row_max) return false;
 
-    for (int row = row_min; row <= row_max; row++) {
-        for (int col = col_min; col <= col_max; col++) {
-            if (!shape_b->solid[row * shape_b->cols + col]) continue;
-            const Rectangle cell_rect = (Rectangle){
-                grid_origin_x + (float)(col * cell),
-                grid_origin_y + (float)(row * cell),
-                (float)cell, (float)cell,
-            };
-            const Rectangle mover = { rect_left, rect_top, shape_a->size.x, shape_a->size.y };
-            if (CheckCollisionRecs(mover, cell_rect)) return true;
+    const size_t row_words = GRID_ROW_WORDS(shape_b->cols);
+    // Rects shorter than a block row would look at as many words through it.
+    if (!shape_b->blocks || row_max - row_min < GRID_BLOCK) {
+        for (int row = row_min; row <= row_max; row++) {
+            if (row_any(shape_b->solid + (size_t)row * row_words, col_min, col_max)) return true;
+        }
+        return false;
+    }
+
+    // Rows of a block row without a solid block in range are skipped whole.
+    const uint64_t *blocks     = shape_b->solid + row_words * (size_t)shape_b->rows;
+    const size_t    block_words = GRID_ROW_WORDS(grid_blocks(shape_b->cols));
+    for (int block_row = row_min / GRID_BLOCK; block_row <= row_max / GRID_BLOCK; block_row++) {
+        if (!row_any(blocks + (size_t)block_row * block_words, col_min / GRID_BLOCK, col_max / GRID_BLOCK)) continue;
+        const int first = (block_row * GRID_BLOCK > row_min)                  ? block_row * GRID_BLOCK                  : row_min;
+        const int last  = (block_row * GRID_BLOCK + GRID_BLOCK - 1 < row_max) ? block_row * GRID_BLOCK + GRID_BLOCK - 1 : row_max;
+        for (int row = first; row <= last; row++) {
+            if (row_any(shape_b->solid + (size_t)row * row_words, col_min, col_max)) return true;
         }
     }
     return false;
@@ -145,6 +184,252 @@ float collide_shape_bottom(const ColliderShape *shape, const Vector2 pos) {
     }
 }
 
+Rectangle collide_shape_bounds(const ColliderShape *shape, const Vector2 pos) {
+    switch (shape->kind) {
+        case SHAPE_RECT: return (Rectangle){ pos.x + shape->as.rect.offset.x, pos.y + shape->as.rect.offset.y, shape->as.rect.size.x, shape->as.rect.size.y };
+        case SHAPE_CIRC: {
+            const float radius = shape->as.circ.radius;
+            return (Rectangle){ pos.x + shape->as.circ.center.x - radius, pos.y + shape->as.circ.center.y - radius, 2.0f * radius, 2.0f * radius };
+        }
+        case SHAPE_PILL: return (Rectangle){ pos.x + shape->as.pill.offset.x, pos.y + shape->as.pill.offset.y, shape->as.pill.size.x, shape->as.pill.size.y };
+        case SHAPE_GRID: return (Rectangle){
+            pos.x + shape->as.grid.offset.x, pos.y + shape->as.grid.offset.y,
+            (float)(shape->as.grid.cols * shape->as.grid.cell_size), (float)(shape->as.grid.rows * shape->as.grid.cell_size),
+        };
+        default:         return (Rectangle){ pos.x, pos.y, 0.0f, 0.0f };
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Bit-packed grids
+// ----------------------------------------------------------------------------
+
+size_t collide_grid_words(const int cols, const int rows, const bool blocks) {
+    size_t words = (size_t)GRID_ROW_WORDS(cols) * (size_t)rows;
+    if (blocks) words += (size_t)GRID_ROW_WORDS(grid_blocks(cols)) * (size_t)grid_blocks(rows);
+    return words;
+}
+
+uint64_t *collide_grid_alloc(Arena *arena, const int cols, const int rows, const bool blocks, const ArenaTag tag) {
+    (void)tag;
+    const size_t words = collide_grid_words(cols, rows, blocks);
+    uint64_t    *solid = ARENA_NEW_ARRAY(arena, uint64_t, words, tag);
+    if (solid) memset(solid, 0, sizeof(uint64_t) * words);
+    return solid;
+}
+
+static void set_bit(uint64_t *row, const int index, const bool value) {
+    const uint64_t bit = 1ull << (index & 63);
+    if (value) row[index >> 6] |=  bit;
+    else       row[index >> 6] &= ~bit;
+}
+
+void collide_grid_pack(ShapeGrid *grid, const uint8_t *cells) {
+    memset(grid->solid, 0, sizeof(uint64_t) * collide_grid_words(grid->cols, grid->rows, grid->blocks));
+    for (int row = 0; row < grid->rows; row++) {
+        for (int col = 0; col < grid->cols; col++) {
+            if (cells[row * grid->cols + col]) collide_grid_set(grid, col, row, true);
+        }
+    }
+}
+
+void collide_grid_set(ShapeGrid *grid, const int col, const int row, const bool solid) {
+    const size_t row_words = GRID_ROW_WORDS(grid->cols);
+    set_bit(grid->solid + (size_t)row * row_words, col, solid);
+    if (!grid->blocks) return;
+
+    // A cleared cell only clears its block if it was the block's last solid one.
+    const int block_col = col / GRID_BLOCK;
+    const int block_row = row / GRID_BLOCK;
+    bool any = solid;
+    if (!any) {
+        const int col_min = block_col * GRID_BLOCK;
+        const int col_max = (col_min + GRID_BLOCK - 1 < grid->cols) ? col_min + GRID_BLOCK - 1 : grid->cols - 1;
+        for (int r = block_row * GRID_BLOCK; r < block_row * GRID_BLOCK + GRID_BLOCK && r < grid->rows && !any; r++) {
+            any = row_any(grid->solid + (size_t)r * row_words, col_min, col_max);
+        }
+    }
+    uint64_t *blocks = grid->solid + row_words * (size_t)grid->rows;
+    set_bit(blocks + (size_t)block_row * GRID_ROW_WORDS(grid_blocks(grid->cols)), block_col, any);
+}
+
+// ----------------------------------------------------------------------------
+// Sweeps: one-pixel steps along one axis
+// ----------------------------------------------------------------------------
+
+// Steps until the leading edge `lead` crosses into the next grid line ahead,
+// the only place a sweep through a grid can start touching a new cell.
+static int32_t steps_to_grid_line(const float lead, const float origin, const float cell, const int dir) {
+    const float lines = (lead - origin) / cell;
+    const float line  = origin + (dir > 0 ? ceilf(lines) : floorf(lines)) * cell;
+    float gap = (dir > 0) ? line - lead : lead - line;
+    // A whole cell away means `lead` sits on a line and rounding picked the
+    // next one: the crossing is the very next step.
+    if (gap > cell - 0.5f) gap = 0.0f;
+    return gap >= 1.0f ? (int32_t)gap : 1;
+}
+
+int32_t collide_shape_steps_apart(const ColliderShape *shape, const Vector2 pos, const Vector2 step, const ColliderShape *other, const Vector2 other_pos) {
+    const Rectangle mover  = collide_shape_bounds(shape, pos);
+    const Rectangle target = collide_shape_bounds(other, other_pos);
+    const bool along_x = step.x != 0.0f;
+    const int  dir     = (int)(along_x ? step.x : step.y);
+
+    // Across the sweep nothing changes: apart there means apart for good.
+    const float mover_lo  = along_x ? mover.y  : mover.x,  mover_hi  = mover_lo  + (along_x ? mover.height  : mover.width);
+    const float target_lo = along_x ? target.y : target.x, target_hi = target_lo + (along_x ? target.height : target.width);
+    if (mover_hi <= target_lo || mover_lo >= target_hi) return COLLIDE_STEPS_NEVER;
+
+    const float mover_min  = along_x ? mover.x  : mover.y,  mover_max  = mover_min  + (along_x ? mover.width  : mover.height);
+    const float target_min = along_x ? target.x : target.y, target_max = target_min + (along_x ? target.width : target.height);
+    const float lead = (dir > 0) ? mover_max : mover_min;
+    const float gap  = (dir > 0) ? target_min - lead : lead - target_max;
+    if ((dir > 0) ? mover_min >= target_max : mover_max <= target_min) return COLLIDE_STEPS_NEVER; // moving away
+    if (gap >= 0.0f) return gap >= 1.0f ? (int32_t)gap : 1;
+
+    // Already inside the target's box without touching the shape: a grid
+    // can only start to at its next grid line, anything else at any step.
+    if (other->kind == SHAPE_GRID && shape->kind != SHAPE_GRID) {
+        const ShapeGrid *grid   = &other->as.grid;
+        const float      origin = along_x ? other_pos.x + grid->offset.x : other_pos.y + grid->offset.y;
+        return steps_to_grid_line(lead, origin, (float)grid->cell_size, dir);
+    }
+    return 1;
+}
+
+// ----------------------------------------------------------------------------
+// Raycasts: segment [from, from + delta], hits reported as t in [0, 1]
+// ----------------------------------------------------------------------------
+
+// Slab test. t_enter is 0 when `from` is inside.
+static bool segment_rect(const Rectangle rect, const Vector2 from, const Vector2 delta, float *t_enter, float *t_exit) {
+    float t_min = 0.0f, t_max = 1.0f;
+    const float origin[2] = { from.x,  from.y  };
+    const float dir   [2] = { delta.x, delta.y };
+    const float lo    [2] = { rect.x,  rect.y  };
+    const float hi    [2] = { rect.x + rect.width, rect.y + rect.height };
+    for (int axis = 0; axis < 2; axis++) {
+        if (dir[axis] == 0.0f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        const float inv = 1.0f / dir[axis];
+        float t_lo = (lo[axis] - origin[axis]) * inv;
+        float t_hi = (hi[axis] - origin[axis]) * inv;
+        if (t_lo > t_hi) { const float swap = t_lo; t_lo = t_hi; t_hi = swap; }
+        if (t_lo > t_min) t_min = t_lo;
+        if (t_hi < t_max) t_max = t_hi;
+        if (t_min > t_max) return false;
+    }
+    *t_enter = t_min;
+    *t_exit  = t_max;
+    return true;
+}
+
+static bool segment_circle(const Vector2 center, const float radius, const Vector2 from, const Vector2 delta, float *out_t) {
+    const Vector2 rel = (Vector2){ from.x - center.x, from.y - center.y };
+    const float   c   = rel.x * rel.x + rel.y * rel.y - radius * radius;
+    if (c <= 0.0f) { *out_t = 0.0f; return true; }
+
+    // |rel + t * delta|^2 = radius^2, nearest root
+    const float a = delta.x * delta.x + delta.y * delta.y;
+    const float b = rel.x * delta.x + rel.y * delta.y;
+    if (a == 0.0f || b >= 0.0f) return false; // standing still, or heading away
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;
+    const float t = (-b - sqrtf(discriminant)) / a;
+    if (t > 1.0f) return false;
+    *out_t = t;
+    return true;
+}
+
+static bool raycast_rect(const ShapeRect *shape, const Vector2 pos, const Vector2 from, const Vector2 delta, float *out_t) {
+    const Rectangle rect = { pos.x + shape->offset.x, pos.y + shape->offset.y, shape->size.x, shape->size.y };
+    float t_exit;
+    return segment_rect(rect, from, delta, out_t, &t_exit);
+}
+
+static bool raycast_circ(const ShapeCirc *shape, const Vector2 pos, const Vector2 from, const Vector2 delta, float *out_t) {
+    const Vector2 center = (Vector2){ pos.x + shape->center.x, pos.y + shape->center.y };
+    return segment_circle(center, shape->radius, from, delta, out_t);
+}
+
+// A pill is its core rect plus a circle at each end; the nearest of the three hits.
+static bool raycast_pill(const ShapePill *shape, const Vector2 pos, const Vector2 from, const Vector2 delta, float *out_t) {
+    const float left = pos.x + shape->offset.x;
+    const float top  = pos.y + shape->offset.y;
+    Rectangle core;
+    Vector2   cap_a, cap_b;
+    float     radius;
+    if (shape->axis == PILL_VERTICAL) {
+        radius = shape->size.x * 0.5f;
+        core   = (Rectangle){ left, top + radius, shape->size.x, shape->size.y - 2.0f * radius };
+        cap_a  = (Vector2){ left + radius, top + radius };
+        cap_b  = (Vector2){ left + radius, top + shape->size.y - radius };
+    } else {
+        radius = shape->size.y * 0.5f;
+        core   = (Rectangle){ left + radius, top, shape->size.x - 2.0f * radius, shape->size.y };
+        cap_a  = (Vector2){ left + radius, top + radius };
+        cap_b  = (Vector2){ left + shape->size.x - radius, top + radius };
+    }
+
+    bool  hit = false;
+    float t, t_exit;
+    *out_t = 1.0f;
+    if (segment_rect(core, from, delta, &t, &t_exit) && t <= *out_t) { *out_t = t; hit = true; }
+    if (segment_circle(cap_a, radius, from, delta, &t) && t <= *out_t) { *out_t = t; hit = true; }
+    if (segment_circle(cap_b, radius, from, delta, &t) && t <= *out_t) { *out_t = t; hit = true; }
+    return hit;
+}
+
+// Walks the cells the segment crosses, in order, until a solid one.
+static bool raycast_grid(const ShapeGrid *shape, const Vector2 pos, const Vector2 from, const Vector2 delta, float *out_t) {
+    const float origin_x = pos.x + shape->offset.x;
+    const float origin_y = pos.y + shape->offset.y;
+    const float cell     = (float)shape->cell_size;
+    const Rectangle bounds = { origin_x, origin_y, (float)shape->cols * cell, (float)shape->rows * cell };
+
+    float t, t_exit;
+    if (shape->cols <= 0 || shape->rows <= 0 || !segment_rect(bounds, from, delta, &t, &t_exit)) return false;
+
+    // Cell of the entry point, clamped: entering exactly on the far edge rounds out of range.
+    int col = (int)floorf((from.x + delta.x * t - origin_x) / cell);
+    int row = (int)floorf((from.y + delta.y * t - origin_y) / cell);
+    if (col < 0) col = 0; else if (col >= shape->cols) col = shape->cols - 1;
+    if (row < 0) row = 0; else if (row >= shape->rows) row = shape->rows - 1;
+
+    // t where the segment crosses the next column/row boundary, and how much t one cell takes.
+    const int   step_x  = (delta.x > 0.0f) - (delta.x < 0.0f);
+    const int   step_y  = (delta.y > 0.0f) - (delta.y < 0.0f);
+    const float next_x  = origin_x + (float)(col + (step_x > 0)) * cell;
+    const float next_y  = origin_y + (float)(row + (step_y > 0)) * cell;
+    float       t_max_x = step_x ? (next_x - from.x) / delta.x : INFINITY;
+    float       t_max_y = step_y ? (next_y - from.y) / delta.y : INFINITY;
+    const float t_cell_x = step_x ? cell / fabsf(delta.x) : INFINITY;
+    const float t_cell_y = step_y ? cell / fabsf(delta.y) : INFINITY;
+
+    for (;;) {
+        if (collide_grid_get(shape, col, row)) {
+            *out_t = t;
+            return true;
+        }
+        if (t_max_x < t_max_y) { col += step_x; t = t_max_x; t_max_x += t_cell_x; }
+        else                   { row += step_y; t = t_max_y; t_max_y += t_cell_y; }
+        if (t > t_exit || col < 0 || col >= shape->cols || row < 0 || row >= shape->rows) return false;
+    }
+}
+
+bool collide_shape_raycast(const ColliderShape *shape, const Vector2 pos, const Vector2 from, const Vector2 to, float *out_t) {
+    const Vector2 delta = (Vector2){ to.x - from.x, to.y - from.y };
+    switch (shape->kind) {
+        case SHAPE_RECT: return raycast_rect(&shape->as.rect, pos, from, delta, out_t);
+        case SHAPE_CIRC: return raycast_circ(&shape->as.circ, pos, from, delta, out_t);
+        case SHAPE_PILL: return raycast_pill(&shape->as.pill, pos, from, delta, out_t);
+        case SHAPE_GRID: return raycast_grid(&shape->as.grid, pos, from, delta, out_t);
+        default:         return false;
+    }
+}
+
 // Inner top/bottom — collapses to the rect-core extents for pill/circ.
 // Used by jumpthru handlers etc. For rect/grid, inner == outer.
 
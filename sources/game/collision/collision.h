@@ -1,6 +1,7 @@
 #ifndef COLLISION_H
 #define COLLISION_H
 
+#include "shared/arena.h"
 #include "shared/ecs_components.h"
 #include "shared/ecs_world.h"
 
@@ -63,4 +64,32 @@ float collide_shape_bottom      (const ColliderShape *shape, Vector2 pos);
 float collide_shape_inner_top   (const ColliderShape *shape, Vector2 pos); // same as top for rect
 float collide_shape_inner_bottom(const ColliderShape *shape, Vector2 pos); // same as bottom for rect
 
+// Bit-packed solid cells for collider_grid(), layout in ecs_components.h.
+// Words a cols x rows grid needs, with the block summary or without.
+size_t    collide_grid_words(int cols, int rows, bool blocks);
+// Cleared cells from the arena, NULL when it's full.
+uint64_t *collide_grid_alloc(Arena *arena, int cols, int rows, bool blocks, ArenaTag tag);
+// Fills the grid from one byte per cell, row-major, non-zero for solid.
+void      collide_grid_pack (ShapeGrid *grid, const uint8_t *cells);
+void      collide_grid_set  (ShapeGrid *grid, int col, int row, bool solid);
+
+static bool collide_grid_get(const ShapeGrid *grid, const int col, const int row) {
+    return (grid->solid[(size_t)row * GRID_ROW_WORDS(grid->cols) + (size_t)(col >> 6)] >> (col & 63)) & 1u;
+}
+
+// World-space bounding box of the shape at `pos`, for the broadphase.
+Rectangle collide_shape_bounds(const ColliderShape *shape, Vector2 pos);
+
+// Lower bound on the one-pixel steps of `step` (one axis, ±1) the shape at
+// `pos` has to take before it can start overlapping `other`: the first step
+// that might, counting from 1. COLLIDE_STEPS_NEVER when moving that way can't
+// ever get it there. Conservative by construction; the exact answer is
+// collide_shape_overlaps() at that step.
+#define COLLIDE_STEPS_NEVER INT32_MAX
+int32_t collide_shape_steps_apart(const ColliderShape *shape, Vector2 pos, Vector2 step, const ColliderShape *other, Vector2 other_pos);
+
+// First point of the segment [from, to] inside the shape at `pos`, as a
+// fraction of the way from `from` (0 when it starts inside). False on a miss.
+bool collide_shape_raycast(const ColliderShape *shape, Vector2 pos, Vector2 from, Vector2 to, float *out_t);
+
 #endif //COLLISION_H
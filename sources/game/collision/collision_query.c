@@ -1,7 +1,54 @@
 #include "shared/ecs_world.h"
 #include "shared/ecs_components.h"
+#include "broadphase.h"
 #include "collision.h"
 
+#include <math.h>
+
+// Keeps out_hits[0, *count) as the lowest handle indices seen so far,
+// ascending: the order the full scan below yields hits in.
+static void keep_hit(EntityId *out_hits, int *count, const int max_hits, const EntityId hit) {
+    int at = *count;
+    while (at > 0 && ENTITY_INDEX(out_hits[at - 1]) > ENTITY_INDEX(hit)) at--;
+    if (at > 0 && out_hits[at - 1] == hit) return; // filed twice, see broadphase_move()
+    if (at == max_hits) return;
+
+    const int last = (*count < max_hits) ? *count : max_hits - 1;
+    for (int i = last; i > at; i--) out_hits[i] = out_hits[i - 1];
+    out_hits[at] = hit;
+    if (*count < max_hits) (*count)++;
+}
+
+static int overlaps_broadphase(
+    World            *world,
+    const Broadphase *broadphase,
+    const Vector2     position, const Collider *collider, const EntityId exclude_id,
+    const Vector2     offset,   const uint32_t effective_mask,
+    EntityId         *out_hits, const int max_hits
+) {
+    const Vector2   moved = (Vector2){ position.x + offset.x, position.y + offset.y };
+    const Rectangle box   = collide_shape_bounds(&collider->shape, moved);
+    int count = 0;
+
+    BroadphaseIter it = broadphase_iter(broadphase, box);
+    while (broadphase_iter_next(&it)) {
+        const EntityId other_id = it.entity;
+        if (other_id == exclude_id) continue;
+        // Full of lower indices already: nothing this one could displace.
+        if (count == max_hits && ENTITY_INDEX(other_id) > ENTITY_INDEX(out_hits[count - 1])) continue;
+
+        const Collider *other_col = world_get_collider(world, other_id);
+        const Position *other_pos = world_get_position(world, other_id);
+        if (!other_col || !other_pos) continue;
+        if ((effective_mask & other_col->mask) == 0) continue;
+
+        if (collide_shape_overlaps(&collider->shape, position, offset, &other_col->shape, *other_pos)) {
+            keep_hit(out_hits, &count, max_hits, other_id);
+        }
+    }
+    return count;
+}
+
 int  collide_overlaps_at_pos(
     const World   *world,
     const Vector2  position, const Collider *collider, const EntityId exclude_id,
@@ -10,19 +57,28 @@ int  collide_overlaps_at_pos(
 ) {
     const uint32_t effective_mask = (mask_filter != 0) ? mask_filter : collider->collides_with;
     int count = 0;
+    if (max_hits <= 0) return 0;
 
-    for (int i = 0; i < world->num_entities && count < max_hits; i++) {
-        if ((EntityId)i == exclude_id)            continue;
-        if (!world->alive[i])                     continue;
-        if (!world->positions.present[i])         continue;
-        if (!world->colliders.present[i])         continue;
+    const Broadphase *broadphase = world->broadphase;
+    if (broadphase && broadphase->valid) {
+        // The component lookups there only read, hence the cast.
+        return overlaps_broadphase((World *)world, broadphase, position, collider, exclude_id, offset, effective_mask, out_hits, max_hits);
+    }
+
+    // Registering the query on first use is the only write, hence the cast.
+    const QueryId query = world_query_cached((World *)world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER), 0);
 
-        const Collider *other_col = &world->colliders.data[i];
+    WorldIter it = world_iter((World *)world, query);
+    while (count < max_hits && world_iter_next(&it)) {
+        const EntityId other_id = it.entity;
+        if (other_id == exclude_id) continue;
+
+        const Collider *other_col = it.components[COMPONENT_COLLIDER];
         if ((effective_mask & other_col->mask) == 0) continue;
 
-        const Vector2 other_pos = world->positions.data[i];
-        if (collide_shape_overlaps(&collider->shape, position, offset, &other_col->shape, other_pos)) {
-            out_hits[count++] = (EntityId)i;
+        const Position *other_pos = it.components[COMPONENT_POSITION];
+        if (collide_shape_overlaps(&collider->shape, position, offset, &other_col->shape, *other_pos)) {
+            out_hits[count++] = other_id;
         }
     }
     return count;
@@ -66,3 +122,138 @@ bool collide_is_on_ground (const World *world, const EntityId entity_id) {
     const Collider *col =  world_get_collider((World*)world, entity_id);
     return collide_is_on_ground_pos(world, pos, col, entity_id);
 }
+
+// First of steps 1..limit at which the collider, stepping from `pos`,
+// overlaps `other`; 0 when it doesn't by then. Only the steps
+// collide_shape_steps_apart() can't rule out get the narrowphase.
+static int32_t first_contact(const Vector2 pos, const Collider *collider, const Vector2 step, const int32_t limit,
+                             const ColliderShape *other, const Vector2 other_pos) {
+    int32_t k = 1;
+    while (k <= limit) {
+        // Where step k starts from: what a one-pixel walk hands the narrowphase.
+        const Vector2 at = (Vector2){ pos.x + step.x * (float)(k - 1), pos.y + step.y * (float)(k - 1) };
+        if (collide_shape_overlaps(&collider->shape, at, step, other, other_pos)) return k;
+
+        const Vector2 after = (Vector2){ at.x + step.x, at.y + step.y };
+        const int32_t apart = collide_shape_steps_apart(&collider->shape, after, step, other, other_pos);
+        if (apart > limit - k) return 0;
+        k += apart;
+    }
+    return 0;
+}
+
+static bool is_ignored(const EntityId *ignore, const int ignore_count, const EntityId entity) {
+    for (int i = 0; i < ignore_count; i++) {
+        if (ignore[i] == entity) return true;
+    }
+    return false;
+}
+
+int collide_sweep_pos(
+    const World   *world,
+    const Vector2  pos,  const Collider *collider, const EntityId exclude_id,
+    const Vector2  step, const int max_steps, const uint32_t mask_filter,
+    const EntityId *ignore, const int ignore_count
+) {
+    if (max_steps <= 0) return 0;
+    // Step k is tested from pos + (k - 1) * step in one go, which only lands
+    // on the floats k - 1 single steps would while the moving coordinate is
+    // a whole number floats still count exactly. Otherwise no steps are
+    // known to be clear and the caller walks them.
+    const float coord = (step.x != 0.0f) ? pos.x : pos.y;
+    if (coord != truncf(coord) || fabsf(coord) > 16777216.0f - (float)max_steps) return 0;
+
+    const uint32_t effective_mask = (mask_filter != 0) ? mask_filter : collider->collides_with;
+    int32_t clear = max_steps; // steps before the earliest contact found so far
+
+    const Broadphase *broadphase = world->broadphase;
+    if (broadphase && broadphase->valid) {
+        const Rectangle first = collide_shape_bounds(&collider->shape, (Vector2){ pos.x + step.x, pos.y + step.y });
+        const Rectangle last  = collide_shape_bounds(&collider->shape, (Vector2){
+            pos.x + step.x * (float)max_steps, pos.y + step.y * (float)max_steps });
+        const float left = fminf(first.x, last.x), right  = fmaxf(first.x + first.width,  last.x + last.width);
+        const float top  = fminf(first.y, last.y), bottom = fmaxf(first.y + first.height, last.y + last.height);
+
+        BroadphaseIter it = broadphase_iter(broadphase, (Rectangle){ left, top, right - left, bottom - top });
+        while (broadphase_iter_next(&it)) {
+            const EntityId other_id = it.entity;
+            if (other_id == exclude_id || is_ignored(ignore, ignore_count, other_id)) continue;
+
+            const Collider *other_col = world_get_collider((World *)world, other_id);
+            const Position *other_pos = world_get_position((World *)world, other_id);
+            if (!other_col || !other_pos) continue;
+            if ((effective_mask & other_col->mask) == 0) continue;
+
+            const int32_t contact = first_contact(pos, collider, step, clear, &other_col->shape, *other_pos);
+            if (contact > 0) clear = contact - 1;
+            if (clear == 0) return 0;
+        }
+        return clear;
+    }
+
+    const QueryId query = world_query_cached((World *)world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER), 0);
+    WorldIter it = world_iter((World *)world, query);
+    while (world_iter_next(&it)) {
+        const EntityId other_id = it.entity;
+        if (other_id == exclude_id || is_ignored(ignore, ignore_count, other_id)) continue;
+
+        const Collider *other_col = it.components[COMPONENT_COLLIDER];
+        if ((effective_mask & other_col->mask) == 0) continue;
+
+        const Position *other_pos = it.components[COMPONENT_POSITION];
+        const int32_t   contact   = first_contact(pos, collider, step, clear, &other_col->shape, *other_pos);
+        if (contact > 0) clear = contact - 1;
+        if (clear == 0) return 0;
+    }
+    return clear;
+}
+
+int collide_query_box(const World *world, const Rectangle box, const uint32_t mask, EntityId *out_hits, const int max_hits) {
+    if (mask == 0) return 0;
+    const Collider probe = collider_rect((Vector2){ 0, 0 }, (Vector2){ box.width, box.height }, COL_NONE, mask);
+    return collide_overlaps_at_pos(world, (Vector2){ box.x, box.y }, &probe, ENTITY_NONE, (Vector2){ 0, 0 }, mask, out_hits, max_hits);
+}
+
+int collide_query_point(const World *world, const Vector2 point, const uint32_t mask, EntityId *out_hits, const int max_hits) {
+    return collide_query_box(world, (Rectangle){ point.x, point.y, 0.0f, 0.0f }, mask, out_hits, max_hits);
+}
+
+// Keeps the nearest hit, ties to the lower handle index.
+static void keep_nearest(const World *world, const EntityId other_id, const Vector2 from, const Vector2 to,
+                         const uint32_t mask, EntityId *best_id, float *best_t) {
+    const Collider *other_col = world_get_collider((World *)world, other_id);
+    const Position *other_pos = world_get_position((World *)world, other_id);
+    if (!other_col || !other_pos || (mask & other_col->mask) == 0) return;
+
+    float t;
+    if (!collide_shape_raycast(&other_col->shape, *other_pos, from, to, &t)) return;
+    if (t < *best_t || (t == *best_t && (*best_id == ENTITY_NONE || ENTITY_INDEX(other_id) < ENTITY_INDEX(*best_id)))) {
+        *best_t  = t;
+        *best_id = other_id;
+    }
+}
+
+bool collide_raycast(const World *world, const Vector2 from, const Vector2 to, const uint32_t mask,
+                     const EntityId exclude_id, EntityId *out_hit, float *out_t) {
+    EntityId best_id = ENTITY_NONE;
+    float    best_t  = 1.0f;
+
+    const Broadphase *broadphase = world->broadphase;
+    if (broadphase && broadphase->valid) {
+        BroadphaseIter it = broadphase_iter_segment(broadphase, from, to);
+        while (broadphase_iter_next(&it)) {
+            if (it.entity != exclude_id) keep_nearest(world, it.entity, from, to, mask, &best_id, &best_t);
+        }
+    } else {
+        const QueryId query = world_query_cached((World *)world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_COLLIDER), 0);
+        WorldIter it = world_iter((World *)world, query);
+        while (world_iter_next(&it)) {
+            if (it.entity != exclude_id) keep_nearest(world, it.entity, from, to, mask, &best_id, &best_t);
+        }
+    }
+
+    if (best_id == ENTITY_NONE) return false;
+    if (out_hit) *out_hit = best_id;
+    if (out_t)   *out_t   = best_t;
+    return true;
+}
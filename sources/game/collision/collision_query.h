@@ -8,9 +8,27 @@ bool collide_first_at_pos     (const World *world, Vector2 pos, const Collider *
 bool collide_would_collide_pos(const World *world, Vector2 pos, const Collider *collider, EntityId exclude_id, Vector2 offset, uint32_t mask_filter);
 bool collide_is_on_ground_pos (const World *world, Vector2 pos, const Collider *collider, EntityId exclude_id);
 
+// How many of `max_steps` one-pixel steps of `step` (one axis, ±1) the
+// collider can take from `pos` before the first step that overlaps
+// something not in `ignore`, found with one broadphase query: max_steps
+// when none does. Up to there, stepping with collide_first_at_pos() would
+// only ever find `ignore`d hits or none. 0 when the moving coordinate isn't
+// a whole number; walk those a pixel at a time.
+int  collide_sweep_pos(const World *world, Vector2 pos, const Collider *collider, EntityId exclude_id,
+                       Vector2 step, int max_steps, uint32_t mask_filter, const EntityId *ignore, int ignore_count);
+
 int  collide_overlaps_at  (const World *, EntityId, Vector2 offset, uint32_t mask, EntityId *out, int max);
 bool collide_first_at     (const World *, EntityId, Vector2 offset, uint32_t mask, EntityId *out);
 bool collide_would_collide(const World *, EntityId, Vector2 offset, uint32_t mask);
 bool collide_is_on_ground (const World *, EntityId);
 
+// Gameplay queries, on whatever broadphase the World has. `mask` selects the
+// layers to report (COL_SOLID | COL_SENSOR ...). Hits come back in ascending
+// handle index.
+int  collide_query_box  (const World *world, Rectangle box, uint32_t mask, EntityId *out_hits, int max_hits);
+int  collide_query_point(const World *world, Vector2 point, uint32_t mask, EntityId *out_hits, int max_hits); // strictly inside
+// Nearest collider the segment [from, to] enters, ties to the lower handle
+// index; *out_t is the fraction of the way there (0 when `from` is inside).
+bool collide_raycast    (const World *world, Vector2 from, Vector2 to, uint32_t mask, EntityId exclude_id, EntityId *out_hit, float *out_t);
+
 #endif //COLLISION_QUERY_H
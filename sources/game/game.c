@@ -14,24 +14,242 @@
 #include "raylib.h"
 #include "raymath.h"
 
+#include <string.h>
+
 #if defined(_WIN32)
   #define GAME_EXPORT __declspec(dllexport)
 #else
   #define GAME_EXPORT __attribute__((visibility("default")))
 #endif
 
-static EntityId spawn_map(GameMemory *m, const Vector2 pos, const char *path) {
-    World *world = &m->world;
+// Component backend for the game world, override with -DGAME_WORLD_STORAGE=WORLD_STORAGE_ARCHETYPE to compare.
+#ifndef GAME_WORLD_STORAGE
+  #define GAME_WORLD_STORAGE WORLD_STORAGE_SPARSE
+#endif
 
-    const EntityId entity = world_create_entity(world);
-    if (entity == ENTITY_NONE) return ENTITY_NONE;
+// Broadphase backend for collision queries, override with -DGAME_BROADPHASE=BROADPHASE_TREE to compare.
+#ifndef GAME_BROADPHASE
+  #define GAME_BROADPHASE BROADPHASE_GRID
+#endif
+
+// The level map, reloaded when its file changes.
+#define GAME_MAP_PATH "maps/example.tmx"
+
+// Map collision comes from the solid layer, override with -DGAME_MAP_MERGE_TILE_OBJECTS=1 to also make
+// solid the tiles of other layers whose collision object fills their cell.
+#ifndef GAME_MAP_MERGE_TILE_OBJECTS
+  #define GAME_MAP_MERGE_TILE_OBJECTS 0
+#endif
+
+// Adapters to the scheduler's SystemFn shape. Only move_platformer borrows
+// scratch memory, for its movers' hit lists.
+static void run_move_platformer(World *world, Arena *scratch, const float dt, const uint32_t begin, const uint32_t end) {
+    (void)begin; (void)end;
+    sys_move_platformer(world, scratch, dt);
+}
+
+static void run_scale_return(World *world, Arena *scratch, const float dt, const uint32_t begin, const uint32_t end) {
+    (void)scratch;
+    sys_scale_return_range(world, dt, begin, end);
+}
+
+static void run_animation(World *world, Arena *scratch, const float dt, const uint32_t begin, const uint32_t end) {
+    (void)scratch;
+    sys_animation_range(world, dt, begin, end);
+}
+
+static void run_bounce_in_bounds(World *world, Arena *scratch, const float dt, const uint32_t begin, const uint32_t end) {
+    (void)scratch; (void)dt;
+    sys_bounce_in_bounds_range(world, world->world_bounds, begin, end);
+}
+
+// Registration order is the order results match. From the declared sets:
+// scale_return and animation run alongside move_platformer, bounce_in_bounds
+// waits for move_platformer (both write Position and Velocity).
+static void build_schedule(Schedule *schedule) {
+    const ComponentMask position        = COMPONENT_BIT(COMPONENT_POSITION);
+    const ComponentMask velocity        = COMPONENT_BIT(COMPONENT_VELOCITY);
+    const ComponentMask collider        = COMPONENT_BIT(COMPONENT_COLLIDER);
+    const ComponentMask move_platformer = COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER);
+    const ComponentMask renderable      = COMPONENT_BIT(COMPONENT_RENDERABLE);
+    const ComponentMask animator        = COMPONENT_BIT(COMPONENT_ANIMATOR);
+
+    schedule_init(schedule);
+    schedule_add(schedule, (SystemDesc){
+        .name     = "move_platformer",
+        .fn       = run_move_platformer,
+        .reads    = collider,                 // other entities' colliders and positions, in collision queries
+        .writes   = position | velocity | move_platformer,
+        .commands = true,                     // collision handlers record structural changes
+    });
+    schedule_add(schedule, (SystemDesc){
+        .name        = "scale_return",
+        .fn          = run_scale_return,
+        .writes      = renderable,
+        .chunk_query = renderable,
+    });
+    schedule_add(schedule, (SystemDesc){
+        .name        = "animation",
+        .fn          = run_animation,
+        .writes      = animator,
+        .chunk_query = animator,
+    });
+    schedule_add(schedule, (SystemDesc){
+        .name        = "bounce_in_bounds",
+        .fn          = run_bounce_in_bounds,
+        .reads       = collider,
+        .writes      = position | velocity,
+        .chunk_query = position | velocity | collider,
+    });
+}
+
+#if ARENA_TELEMETRY
+#define GAME_MAX_ARENAS (4 + JOBS_MAX_WORKERS + ATLAS_COUNT)
+
+// Every arena in GameMemory, for telemetry. Returns how many were written.
+static int game_arenas(GameMemory *m, Arena *arenas[GAME_MAX_ARENAS], const char *names[GAME_MAX_ARENAS]) {
+    int count = 0;
+    arenas[count] = &m->arena;       names[count++] = "root";
+    arenas[count] = &m->level_arena; names[count++] = "level";
+    for (int i = 0; i < 2; i++) {
+        arenas[count] = &m->map_arenas[i]; names[count++] = "map";
+    }
+    for (uint32_t worker = 0; worker < JOBS_MAX_WORKERS; worker++) {
+        arenas[count] = &m->scratch[worker]; names[count++] = "scratch";
+    }
+    for (AtlasId id = 1; id < ATLAS_COUNT; id++) {
+        arenas[count] = &m->assets.atlases[id].arena; names[count++] = "atlas";
+    }
+    return count;
+}
+#endif
+
+// raytmx's allocator over an arena. Nothing comes back one block at a time.
+static void *tmx_arena_alloc(void *arena, const size_t size) {
+    return arena_alloc((Arena *)arena, size, 16, ARENA_TAG_TILEMAP);
+}
+
+typedef struct {
+    uint32_t solid_layers; // TILEMAP_LAYER_COLLISION tile layers found
+    uint32_t merged;       // tiles made solid by a collision object filling their cell
+    uint32_t partial;      // tiles whose collision objects don't fill it, left out
+} MapGridStats;
+
+// True when one of the tile's collision objects is an unrotated rectangle over
+// its whole cell, the only shape a grid cell can stand for.
+static bool tile_fills_cell(const TmxMap *tmx, const TmxTile *tile) {
+    if (tile->dimensions.x != (float)tmx->tileWidth || tile->dimensions.y != (float)tmx->tileHeight) return false;
+    for (uint32_t i = 0; i < tile->objectGroup.objectsLength; i++) {
+        const TmxObject *object = &tile->objectGroup.objects[i];
+        if (object->type != OBJECT_TYPE_RECTANGLE || object->rotation != 0.0) continue;
+        if (object->x <= 0.0 && object->x + object->width  >= (double)tmx->tileWidth &&
+            object->y <= 0.0 && object->y + object->height >= (double)tmx->tileHeight) return true;
+    }
+    return false;
+}
+
+// Marks every tile of the TILEMAP_LAYER_COLLISION layers in `layers` (groups
+// included) solid in `grid`, and with `merge_objects` the tiles of the other
+// tile layers that tile_fills_cell(). Layer offsets are not applied; cells stay
+// on the map's tiles.
+static void mark_solid_cells(ShapeGrid *grid, const TmxMap *tmx, const TmxLayer *layers, const uint32_t count,
+                             const bool merge_objects, MapGridStats *stats) {
+    for (uint32_t i = 0; i < count; i++) {
+        const TmxLayer *layer = &layers[i];
+        if (layer->type == LAYER_TYPE_GROUP) {
+            mark_solid_cells(grid, tmx, layer->layers, layer->layersLength, merge_objects, stats);
+            continue;
+        }
+        if (layer->type != LAYER_TYPE_TILE_LAYER) continue;
+
+        const bool solid = layer->name && strcmp(layer->name, TILEMAP_LAYER_COLLISION) == 0;
+        if (!solid && !merge_objects) continue;
+        stats->solid_layers += solid;
+
+        const TmxTileLayer *tiles = &layer->exact.tileLayer;
+        const uint32_t      cols  = tiles->width  < (uint32_t)grid->cols ? tiles->width  : (uint32_t)grid->cols;
+        const uint32_t      rows  = tiles->height < (uint32_t)grid->rows ? tiles->height : (uint32_t)grid->rows;
+        for (uint32_t row = 0; row < rows; row++) {
+            for (uint32_t col = 0; col < cols && row * tiles->width + col < tiles->tilesLength; col++) {
+                const uint32_t gid = GetGid(tiles->tiles[row * tiles->width + col], NULL, NULL, NULL, NULL);
+                if (gid == 0) continue;
+                if (solid) {
+                    collide_grid_set(grid, (int)col, (int)row, true);
+                    continue;
+                }
+                if (gid >= tmx->gidsToTilesLength || tmx->gidsToTiles[gid].objectGroup.objectsLength == 0) continue;
+                if (tile_fills_cell(tmx, &tmx->gidsToTiles[gid])) {
+                    collide_grid_set(grid, (int)col, (int)row, true);
+                    stats->merged++;
+                } else {
+                    stats->partial++;
+                }
+            }
+        }
+    }
+}
 
-    TmxMap *tmx = LoadTMX(path);
+// Compiles the map's solid tiles into one SHAPE_GRID collider, its cells in
+// `arena` next to the map. False, with nothing left in the arena, when the
+// map has no solid tiles or non-square ones.
+static bool build_map_collider(Arena *arena, const TmxMap *tmx, const Vector2 pos, Collider *out) {
+    if (tmx->tileWidth != tmx->tileHeight) {
+        TraceLog(LOG_WARNING, "spawn_map(): %ux%u tiles in '%s', no collision grid", tmx->tileWidth, tmx->tileHeight, tmx->fileName);
+        return false;
+    }
+
+    const int       cols  = (int)tmx->width;
+    const int       rows  = (int)tmx->height;
+    const ArenaMark mark  = arena_mark(arena);
+    // No block summary: bench_grid has it about even for movers and behind for large boxes.
+    uint64_t       *solid = collide_grid_alloc(arena, cols, rows, false, ARENA_TAG_COLLISION);
+    if (!solid) {
+        TraceLog(LOG_WARNING, "spawn_map(): no room for the collision grid of '%s'", tmx->fileName);
+        return false;
+    }
+
+    *out = collider_grid((int)tmx->tileWidth, cols, rows, solid, false, COL_SOLID, COL_NONE);
+    // DrawTMX() draws the map at the world origin, not at the entity; the cells go where the tiles are drawn.
+    out->shape.as.grid.offset = (Vector2){ -pos.x, -pos.y };
+
+    MapGridStats stats = { 0 };
+    mark_solid_cells(&out->shape.as.grid, tmx, tmx->layers, tmx->layersLength, GAME_MAP_MERGE_TILE_OBJECTS, &stats);
+    if (stats.partial > 0) {
+        TraceLog(LOG_INFO, "spawn_map(): %u tiles in '%s' have collision objects smaller than a cell, left out of the grid",
+            stats.partial, tmx->fileName);
+    }
+    if (stats.solid_layers == 0 && stats.merged == 0) {
+        arena_restore(mark);
+        return false;
+    }
+    return true;
+}
+
+// Loads the map into the idle map arena and spawns an entity for it, leaving
+// the live map alone; the caller makes the new one live. ENTITY_NONE when the
+// map doesn't load.
+static EntityId spawn_map(GameMemory *m, const Vector2 pos, const char *path) {
+    World *world = &m->world;
+    Arena *arena = &m->map_arenas[m->map_live ^ 1];
+    arena_reset(arena);
+
+    // Parse on top of the root arena and drop all of it at once; only the
+    // packed map, one block in the map arena, stays.
+    const ArenaMark parse_mark = arena_mark(&m->arena);
+    TmxMap *tmx = LoadTMXInto(path, (TmxAllocator){ tmx_arena_alloc, arena },
+                                    (TmxAllocator){ tmx_arena_alloc, &m->arena });
+    arena_restore(parse_mark);
     if (!tmx) {
         TraceLog(LOG_WARNING, "spawn_map(): failed to load map '%s'", path);
         return ENTITY_NONE;
     }
 
+    const EntityId entity = world_create_entity(world);
+    if (entity == ENTITY_NONE) {
+        UnloadTMX(tmx);
+        return ENTITY_NONE;
+    }
+
     const uint32_t cols = tmx->width;
     const uint32_t rows = tmx->height;
     const uint32_t size = tmx->tileWidth;
@@ -50,45 +268,74 @@ static EntityId spawn_map(GameMemory *m, const Vector2 pos, const char *path) {
         .tile_size = size,
     });
 
+    Collider collider;
+    if (build_map_collider(arena, tmx, pos, &collider)) world_set_collider(world, entity, collider);
+
     return entity;
 }
 
-static EntityId spawn_animated(
-    GameMemory    *m,
-    const Vector2  pos,
-    const Vector2  vel,
-    const Vector2  size,
-    const int      layer,
-    const char    *anim_tag
-) {
-    World        *world  = &m->world;
-    Arena        *arena  = &m->arena;
-    const Assets *assets = &m->assets;
-
-    const EntityId entity = world_create_entity(world);
-    if (entity == ENTITY_NONE) return ENTITY_NONE;
-
-    const Vector2  zero = (Vector2){ 0, 0 };
+// Swaps in a fresh copy of the map when its file changed. Each version of the
+// file is tried once: one that fails to load keeps the old map live until the
+// next edit, rather than being reparsed every tick.
+static void poll_map_reload(GameMemory *m) {
+    const long mtime = GetFileModTime(GAME_MAP_PATH);
+    if (mtime == 0 || mtime == m->map_mtime) return;
+    m->map_mtime = mtime;
+
+    World          *world = &m->world;
+    const Position *old   = world_get_position(world, m->entity_map);
+    const EntityId  fresh = spawn_map(m, old ? *old : (Position){ 0, 0 }, GAME_MAP_PATH);
+    if (fresh == ENTITY_NONE) return;
+
+    const Tilemap *tilemap = world_get_tilemap(world, m->entity_map);
+    if (tilemap) UnloadTMX(tilemap->map);
+    world_destroy_entity(world, m->entity_map);
+
+    m->entity_map = fresh;
+    m->map_live  ^= 1;
+    TraceLog(LOG_INFO, "reloaded map %s", GAME_MAP_PATH);
+}
 
-    world_set_position       (world, entity, pos);
-    world_set_velocity       (world, entity, (Velocity){ .value = vel, .remainder = zero });
-    world_set_renderable     (world, entity, (Renderable){ RENDERABLE_DEFAULTS, .size = size, .layer = layer });
-    world_set_collider       (world, entity, collider_rect(zero, size, COL_PLAYER, COL_PLAYER | COL_SOLID));
-    world_set_move_platformer(world, entity, (MovePlatformer){ MOVE_PLATFORMER_DEFAULTS });
+// Template for the animated test actors. The atlas lookup (two strcmp passes
+// plus an arena allocation) happens here, once per prefab, not per spawn.
+static Prefab animated_prefab(GameMemory *m, const Vector2 size, const int layer, const char *anim_tag) {
+    const Vector2 zero = (Vector2){ 0, 0 };
+
+    Prefab prefab = (Prefab){
+        .components      = COMPONENT_BIT(COMPONENT_POSITION)   | COMPONENT_BIT(COMPONENT_VELOCITY) |
+                           COMPONENT_BIT(COMPONENT_RENDERABLE) | COMPONENT_BIT(COMPONENT_COLLIDER) |
+                           COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER),
+        .velocity        = (Velocity){ .value = zero, .remainder = zero },
+        .renderable      = (Renderable){ RENDERABLE_DEFAULTS, .size = size, .layer = layer },
+        .collider        = collider_rect(zero, size, COL_PLAYER, COL_PLAYER | COL_SOLID),
+        .move_platformer = (MovePlatformer){ MOVE_PLATFORMER_DEFAULTS },
+    };
 
-    const Atlas        *atlas         = assets_get_atlas(assets, ATLAS_HERO);
-    const AtlasRegions  atlas_regions = atlas_find_regions_by_tag(atlas, anim_tag, arena);
+    const Atlas        *atlas         = assets_get_atlas(&m->assets, ATLAS_HERO);
+    const AtlasRegions  atlas_regions = atlas_find_regions_by_tag(atlas, anim_tag, &m->level_arena);
     if (atlas_regions.count > 0) {
-        world_set_animator(world, entity, (Animator){
+        prefab.animator = (Animator){
             ANIMATOR_DEFAULTS,
             .mode          = ANIM_LOOP,
             .frames        = atlas_regions,
             .frame_seconds = 0.1f,
-        });
+        };
+        prefab.components |= COMPONENT_BIT(COMPONENT_ANIMATOR);
     } else {
         TraceLog(LOG_WARNING, "anim(%s): no atlas regions found", anim_tag);
     }
 
+    return prefab;
+}
+
+static EntityId spawn_animated(GameMemory *m, const Prefab *prefab, const Vector2 pos, const Vector2 vel) {
+    World *world = &m->world;
+
+    EntityId entity;
+    if (world_spawn_batch(world, prefab, 1, &entity) == 0) return ENTITY_NONE;
+
+    world_set_position(world, entity, pos);
+    world_set_velocity(world, entity, (Velocity){ .value = vel, .remainder = (Vector2){ 0, 0 } });
     return entity;
 }
 
@@ -103,20 +350,39 @@ GAME_EXPORT void game_load(GameMemory *m) {
         m->world_prev = m->world_curr;
 
         assets_init(&m->assets, &m->arena);
+        world_init (&m->world,  &m->arena, GAME_WORLD_STORAGE);
+        commands_init(&m->commands, &m->arena);
+        broadphase_init(&m->broadphase, &m->arena, GAME_BROADPHASE, MAX_RENDER_INSTANCES);
+        m->world.commands   = &m->commands;
+        m->world.broadphase = &m->broadphase;
+        m->level_arena      = arena_sub(&m->arena, LEVEL_ARENA_BYTES, ARENA_TAG_LEVEL);
+        m->map_arenas[0]    = arena_sub(&m->arena, MAP_ARENA_BYTES,   ARENA_TAG_TILEMAP);
+        m->map_arenas[1]    = arena_sub(&m->arena, MAP_ARENA_BYTES,   ARENA_TAG_TILEMAP);
+        for (uint32_t worker = 0; worker < JOBS_MAX_WORKERS; worker++) {
+            m->scratch[worker] = arena_sub(&m->arena, SCRATCH_ARENA_BYTES, ARENA_TAG_SCRATCH);
+        }
+        hash_map_init(&m->prev_instances, &m->arena, MAX_RENDER_INSTANCES, ARENA_TAG_ECS);
+        m->tilemap_query    = world_query_cached(&m->world, COMPONENT_BIT(COMPONENT_TILEMAP), 0);
 
         const Vector2 size  = (Vector2){  100, 100 };
         const Vector2 vel_1 = (Vector2){  200, 140 };
         const Vector2 vel_2 = (Vector2){ -200, 140 };
         const Vector2 pos_1 = (Vector2){ screen_center.x, screen_center.y + 50};
         const Vector2 pos_2 = (Vector2){ screen_center.x, screen_center.y - 50 - size.y };
-        m->test_entity_1 = spawn_animated(m, pos_1, vel_1, size, 0, "hero-idle");
-        m->test_entity_2 = spawn_animated(m, pos_2, vel_2, size, 1, "hero-run");
+        const Prefab hero_idle = animated_prefab(m, size, 0, "hero-idle");
+        const Prefab hero_run  = animated_prefab(m, size, 1, "hero-run");
+        m->test_entity_1 = spawn_animated(m, &hero_idle, pos_1, vel_1);
+        m->test_entity_2 = spawn_animated(m, &hero_run,  pos_2, vel_2);
 
-        m->entity_map = spawn_map(m, screen_center, "maps/example.tmx");
+        m->map_mtime  = GetFileModTime(GAME_MAP_PATH);
+        m->entity_map = spawn_map(m, screen_center, GAME_MAP_PATH);
+        if (m->entity_map != ENTITY_NONE) m->map_live ^= 1;
+        world_log_memory(&m->world);
 
         m->initialized = true;
     }
     // NOTE: Re-bind anything tied to this module's code/.rodata here.
+    build_schedule(&m->schedule);
     // GameWorld values are already valid because GameMemory lives in the platform.
 }
 
@@ -133,6 +399,11 @@ GAME_EXPORT void game_update(GameMemory *m, const GameInput *input, const float
     WorldSnapshot *snapshot = &m->world_curr;
     World *world            = &m->world;
 
+    // game_render() finds each instance's previous state through this.
+    const RenderSnapshot *prev = &m->world_prev.render;
+    hash_map_clear(&m->prev_instances);
+    for (uint32_t i = 0; i < prev->count; i++) hash_map_put(&m->prev_instances, prev->instances[i].entity_id, i);
+
     // TESTING: squash, stretch
     if (input->key_space) {
         Renderable *renderable = world_get_renderable(world, m->test_entity_1);
@@ -143,15 +414,33 @@ GAME_EXPORT void game_update(GameMemory *m, const GameInput *input, const float
 
     // TODO: camera update will go here, none yet though because it's static
 
-    // Run entity systems, ORDER MATTERS!
-    // sys_integrate_velocity(world, dt);
-    sys_move_platformer (world, dt);
-    sys_scale_return    (world, dt);
-    sys_animation       (world, dt);
-    sys_bounce_in_bounds(world, world->world_bounds);
+    // An edited map is swapped in before anything queries its collider.
+    poll_map_reload(m);
+
+    // Collision queries this tick start from where everything is now.
+    broadphase_update(&m->broadphase, world);
+
+    // Run entity systems. What may overlap follows from the sets declared in
+    // build_schedule(); results match running them in registration order.
+    schedule_run(&m->schedule, world, &m->jobs, m->scratch, dt);
+
+    // Sync point: structural changes recorded by the systems above take effect here.
+    commands_playback(&m->commands, world);
+    // Also the one point no query is in flight; shrink the scanned range once a wave has died off.
+    world_maybe_compact(world);
 
     extract_render_snapshot(world, &m->assets, &snapshot->render);
     snapshot->tick++;
+
+#if ARENA_TELEMETRY
+    Arena      *arenas[GAME_MAX_ARENAS];
+    const char *names [GAME_MAX_ARENAS];
+    const int   num_arenas = game_arenas(m, arenas, names);
+    for (int i = 0; i < num_arenas; i++) arena_telemetry_tick(arenas[i], (double)snapshot->tick * dt);
+#endif
+
+    // Nothing borrowed from scratch outlives the tick, whatever a system forgot to restore.
+    for (uint32_t worker = 0; worker < JOBS_MAX_WORKERS; worker++) arena_reset(&m->scratch[worker]);
 }
 
 GAME_EXPORT void game_render(const GameMemory *m, const float alpha) {
@@ -177,9 +466,10 @@ GAME_EXPORT void game_render(const GameMemory *m, const float alpha) {
     }
 
     // TODO: Tilemap component is kind of a Renderable, decide how to integrate it properly
-    for (int i = 0; i < m->world.num_entities; i++) {
-        const Tilemap *tilemap = world_get_tilemap(&m->world, i);
-        if (tilemap && tilemap->map) {
+    WorldIter tilemaps = world_iter(&m->world, m->tilemap_query);
+    while (world_iter_next(&tilemaps)) {
+        const Tilemap *tilemap = tilemaps.components[COMPONENT_TILEMAP];
+        if (tilemap->map) {
             AnimateTMX(tilemap->map);
             DrawTMX(tilemap->map, &camera, NULL, 0, 0, WHITE);
         }
@@ -190,20 +480,15 @@ GAME_EXPORT void game_render(const GameMemory *m, const float alpha) {
     const RenderSnapshot *curr = &m->world_curr.render;
     for (uint32_t i = 0; i < curr->count; i++) {
         const RenderInstance *curr_inst = &curr->instances[i];
-        const RenderInstance *prev_inst = NULL;
 
         // Skip if there's nothing to draw for this component renderer instance
         const Texture2D texture = curr_inst->texture;
         if (texture.id == 0) continue;
 
-        // Find matching instances between prev and curr based on stable id matches...
-        // Linear scan; fine for now, change to hash lookup above ~200 entities
-        for (uint32_t j = 0; j < prev->count; j++) {
-            if (prev->instances[j].entity_id == curr->instances[i].entity_id) {
-                prev_inst = &prev->instances[j];
-                break;
-            }
-        }
+        // Find matching instances between prev and curr based on stable id matches
+        uint32_t              prev_index;
+        const RenderInstance *prev_inst = hash_map_get(&m->prev_instances, curr_inst->entity_id, &prev_index)
+                                        ? &prev->instances[prev_index] : NULL;
 
         const Vector2 pos = prev_inst ? (Vector2) {
             Lerp(prev_inst->position.x, curr_inst->position.x, alpha),
@@ -229,10 +514,18 @@ GAME_EXPORT void game_render(const GameMemory *m, const float alpha) {
 GAME_EXPORT void game_shutdown(GameMemory *m) {
     // Final teardown — release every GPU/audio handle. Called once at exit,
     // before raylib's GL context is destroyed by CloseWindow().
+#if ARENA_TELEMETRY
+    // Before assets_unload_all() clears the atlas arenas.
+    Arena      *arenas[GAME_MAX_ARENAS];
+    const char *names [GAME_MAX_ARENAS];
+    const int   num_arenas = game_arenas(m, arenas, names);
+    arena_telemetry_dump(TextFormat("%sarena_telemetry.txt", GetApplicationDirectory()),
+                         (const Arena *const *)arenas, names, num_arenas);
+#endif
     assets_unload_all(&m->assets);
 
-    for (int i = 0; i < m->world.num_entities; i++) {
-        const Tilemap *tilemap = world_get_tilemap(&m->world, i);
-        if (tilemap) UnloadTMX(tilemap->map);
+    WorldIter tilemaps = world_iter(&m->world, m->tilemap_query);
+    while (world_iter_next(&tilemaps)) {
+        UnloadTMX(((Tilemap *)tilemaps.components[COMPONENT_TILEMAP])->map);
     }
 }
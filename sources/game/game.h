@@ -1,9 +1,14 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "game/collision/broadphase.h"
 #include "shared/arena.h"
 #include "shared/assets.h"
+#include "shared/ecs_commands.h"
+#include "shared/ecs_schedule.h"
 #include "shared/ecs_world.h"
+#include "shared/hash_map.h"
+#include "shared/jobs.h"
 #include "raylib.h"
 
 #include <stdbool.h>
@@ -24,6 +29,36 @@ typedef struct {
 
 #define MAX_RENDER_INSTANCES 4096
 
+// Address space the platform reserves for GameMemory.arena, right after
+// GameMemory itself. Committed as it fills, so the size is a ceiling, not a cost.
+#define GAME_ARENA_BYTES (1024ull * 1024 * 1024)
+
+// Carved from GameMemory.arena for what lives as long as the current level:
+// prefab animation frames, for now. Reset when the level changes.
+#define LEVEL_ARENA_BYTES (16 * 1024 * 1024)
+
+// Two of these are carved from GameMemory.arena for the loaded map: the packed
+// TMX and its compiled collision grid. A map hot reload loads into the idle
+// one, so a broken edit leaves the live map alone. Committed as they fill.
+#define MAP_ARENA_BYTES   (16 * 1024 * 1024)
+
+// One of these per job worker is carved from GameMemory.arena for data that
+// only lives inside one tick, such as the hits a mover has answered this step
+// (see move_step_pixels()). A worker owns its own, so borrowing needs no lock,
+// and all of them are reset at the end of every game_update(). Borrow with a
+// mark and give it back before returning:
+//
+//   const ArenaMark mark = arena_mark(scratch);
+//   EntityId *hits = ARENA_NEW_ARRAY(scratch, EntityId, count, ARENA_TAG_COLLISION);
+//   ...
+//   arena_restore(mark);
+//
+// Marks nest like a stack. A worker waiting in jobs_wait() may run other jobs
+// that borrow the same scratch in between, which is fine as long as every job
+// restores its own mark before it returns. Committed as they fill, so a worker
+// that never borrows costs nothing.
+#define SCRATCH_ARENA_BYTES (4 * 1024 * 1024)
+
 typedef struct {
     RenderInstance  instances[MAX_RENDER_INSTANCES];
     uint32_t        count;
@@ -47,14 +82,27 @@ typedef struct {
 } WorldSnapshot;
 
 // Persistent state owned by the platform. Survives hot reloads because the
-// platform never frees it; only the .dll/.so is unloaded and reloaded.
+// platform never frees it; only the .dll/.so is unloaded and reloaded. Lives
+// at the start of a reservation the platform makes at a fixed base address,
+// zeroed, with `arena` set up over the rest of it before game_load().
 typedef struct {
     bool          initialized;
     Assets        assets;
-    Arena         arena;
+    Arena         arena;         // GAME_ARENA_BYTES reserved, for what lives until shutdown
+    Arena         level_arena;   // carved from `arena`, see LEVEL_ARENA_BYTES
+    Arena         map_arenas[2]; // carved from `arena`, see MAP_ARENA_BYTES; the live map is in map_arenas[map_live]
+    uint32_t      map_live;
+    long          map_mtime;     // of the map file as last loaded or tried, polled by game_update() for hot reload
     World         world;
+    QueryId       tilemap_query; // registered by game_load(), so game_render() can walk it through a const World
+    CommandBuffer commands;      // structural changes recorded during a tick, played back at its sync point
+    Broadphase    broadphase;    // collider spatial hash, rebuilt at the start of every game_update()
+    JobSystem     jobs;          // started and stopped by the platform, so the threads outlive module reloads
+    Arena         scratch[JOBS_MAX_WORKERS]; // carved from `arena`, one per job worker, see SCRATCH_ARENA_BYTES
+    Schedule      schedule;      // tick systems; holds module function pointers, rebuilt by every game_load()
     WorldSnapshot world_prev;
     WorldSnapshot world_curr;
+    HashMap       prev_instances; // entity_id -> index in world_prev.render.instances, rebuilt every tick
     EntityId      test_entity_1;
     EntityId      test_entity_2;
     EntityId      entity_map;
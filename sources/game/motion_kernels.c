@@ -0,0 +1,227 @@
+#include "game/motion_kernels.h"
+
+#include <math.h>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+  #include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  #include <arm_neon.h>
+#endif
+
+// ----------------------------------------------------------------------------
+// Scalar bodies, used for run tails and on targets without a vector path
+// ----------------------------------------------------------------------------
+
+static void integrate_one(Position *pos, const Velocity *vel, const float dt) {
+    pos->x += vel->value.x * dt;
+    pos->y += vel->value.y * dt;
+}
+
+static void accumulate_one(Velocity *vel, const float dt, int32_t *out_step) {
+    // truncf() is symmetric around zero, see move_step_dt()
+    const float total_x = vel->remainder.x + vel->value.x * dt;
+    const float total_y = vel->remainder.y + vel->value.y * dt;
+    out_step[0]      = (int32_t)truncf(total_x);
+    out_step[1]      = (int32_t)truncf(total_y);
+    vel->remainder.x = total_x - (float)out_step[0];
+    vel->remainder.y = total_y - (float)out_step[1];
+}
+
+static void bounce_one(Position *pos, Velocity *vel, const Collider *col, const Bounds bounds) {
+    const float world_right  = bounds.x + bounds.width;
+    const float world_bottom = bounds.y + bounds.height;
+
+    const ShapeRect collider_rect = col->shape.as.rect;
+    const float collider_left     = pos->x + collider_rect.offset.x;
+    const float collider_top      = pos->y + collider_rect.offset.y;
+    const float collider_right    = collider_left + collider_rect.size.x;
+    const float collider_bottom   = collider_top  + collider_rect.size.y;
+
+    // Keep positions in bounds, invert velocities if at bounds
+    if (collider_left   < bounds.x)     { pos->x += (bounds.x        - collider_left); if (vel->value.x < 0) vel->value.x = -vel->value.x; }
+    if (collider_right  > world_right)  { pos->x -= (collider_right  - world_right);   if (vel->value.x > 0) vel->value.x = -vel->value.x; }
+    if (collider_top    < bounds.y)     { pos->y += (bounds.y        - collider_top);  if (vel->value.y < 0) vel->value.y = -vel->value.y; }
+    if (collider_bottom > world_bottom) { pos->y -= (collider_bottom - world_bottom);  if (vel->value.y > 0) vel->value.y = -vel->value.y; }
+}
+
+// ----------------------------------------------------------------------------
+// Kernels
+// ----------------------------------------------------------------------------
+//
+// Lane layout: a Velocity is 4 floats (value.x, value.y, remainder.x,
+// remainder.y). The vector bodies load whole Velocities and shuffle the value
+// halves of neighbouring entities together so they line up with the packed
+// x, y pairs of the Positions, and the remainder halves likewise.
+
+void motion_integrate(Position *pos, const Velocity *vel, const uint32_t count, const float dt) {
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256 dt_v = _mm256_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        const __m256 v01   = _mm256_loadu_ps(&vel[i    ].value.x);
+        const __m256 v23   = _mm256_loadu_ps(&vel[i + 2].value.x);
+        const __m256 v02   = _mm256_permute2f128_ps(v01, v23, 0x20);
+        const __m256 v13   = _mm256_permute2f128_ps(v01, v23, 0x31);
+        const __m256 value = _mm256_shuffle_ps(v02, v13, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 p     = _mm256_loadu_ps(&pos[i].x);
+        _mm256_storeu_ps(&pos[i].x, _mm256_add_ps(p, _mm256_mul_ps(value, dt_v)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 dt_v = _mm_set1_ps(dt);
+    for (; i + 2 <= count; i += 2) {
+        const __m128 value = _mm_movelh_ps(_mm_loadu_ps(&vel[i].value.x), _mm_loadu_ps(&vel[i + 1].value.x));
+        const __m128 p     = _mm_loadu_ps(&pos[i].x);
+        _mm_storeu_ps(&pos[i].x, _mm_add_ps(p, _mm_mul_ps(value, dt_v)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float32x4_t dt_v = vdupq_n_f32(dt);
+    for (; i + 2 <= count; i += 2) {
+        const float32x4_t value = vcombine_f32(vld1_f32(&vel[i].value.x), vld1_f32(&vel[i + 1].value.x));
+        vst1q_f32(&pos[i].x, vmlaq_f32(vld1q_f32(&pos[i].x), value, dt_v));
+    }
+#endif
+    for (; i < count; i++) integrate_one(&pos[i], &vel[i], dt);
+}
+
+void motion_accumulate(Velocity *vel, const uint32_t count, const float dt, int32_t *out_steps) {
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256 dt_v = _mm256_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        const __m256  v01   = _mm256_loadu_ps(&vel[i    ].value.x);
+        const __m256  v23   = _mm256_loadu_ps(&vel[i + 2].value.x);
+        const __m256  v02   = _mm256_permute2f128_ps(v01, v23, 0x20);
+        const __m256  v13   = _mm256_permute2f128_ps(v01, v23, 0x31);
+        const __m256  value = _mm256_shuffle_ps(v02, v13, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256  rem   = _mm256_shuffle_ps(v02, v13, _MM_SHUFFLE(3, 2, 3, 2));
+        const __m256  total = _mm256_add_ps(rem, _mm256_mul_ps(value, dt_v));
+        const __m256i steps = _mm256_cvttps_epi32(total); // truncates towards zero
+        const __m256  frac  = _mm256_sub_ps(total, _mm256_cvtepi32_ps(steps));
+        _mm256_storeu_si256((__m256i *)&out_steps[2 * i], steps);
+
+        // Undo the shuffle with the fractions in the remainder halves.
+        const __m256 out02 = _mm256_shuffle_ps(value, frac, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m256 out13 = _mm256_shuffle_ps(value, frac, _MM_SHUFFLE(3, 2, 3, 2));
+        _mm256_storeu_ps(&vel[i    ].value.x, _mm256_permute2f128_ps(out02, out13, 0x20));
+        _mm256_storeu_ps(&vel[i + 2].value.x, _mm256_permute2f128_ps(out02, out13, 0x31));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 dt_v = _mm_set1_ps(dt);
+    for (; i + 2 <= count; i += 2) {
+        const __m128  v0    = _mm_loadu_ps(&vel[i    ].value.x);
+        const __m128  v1    = _mm_loadu_ps(&vel[i + 1].value.x);
+        const __m128  value = _mm_movelh_ps(v0, v1);
+        const __m128  rem   = _mm_movehl_ps(v1, v0);
+        const __m128  total = _mm_add_ps(rem, _mm_mul_ps(value, dt_v));
+        const __m128i steps = _mm_cvttps_epi32(total); // truncates towards zero
+        const __m128  frac  = _mm_sub_ps(total, _mm_cvtepi32_ps(steps));
+        _mm_storeu_si128((__m128i *)&out_steps[2 * i], steps);
+        _mm_storeu_ps(&vel[i    ].value.x, _mm_movelh_ps(v0, frac));
+        _mm_storeu_ps(&vel[i + 1].value.x, _mm_shuffle_ps(v1, frac, _MM_SHUFFLE(3, 2, 1, 0)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float32x4_t dt_v = vdupq_n_f32(dt);
+    for (; i + 2 <= count; i += 2) {
+        const float32x4_t v0    = vld1q_f32(&vel[i    ].value.x);
+        const float32x4_t v1    = vld1q_f32(&vel[i + 1].value.x);
+        const float32x4_t value = vcombine_f32(vget_low_f32 (v0), vget_low_f32 (v1));
+        const float32x4_t rem   = vcombine_f32(vget_high_f32(v0), vget_high_f32(v1));
+        const float32x4_t total = vmlaq_f32(rem, value, dt_v);
+        const int32x4_t   steps = vcvtq_s32_f32(total); // truncates towards zero
+        const float32x4_t frac  = vsubq_f32(total, vcvtq_f32_s32(steps));
+        vst1q_s32(&out_steps[2 * i], steps);
+        vst1q_f32(&vel[i    ].value.x, vcombine_f32(vget_low_f32(v0), vget_low_f32 (frac)));
+        vst1q_f32(&vel[i + 1].value.x, vcombine_f32(vget_low_f32(v1), vget_high_f32(frac)));
+    }
+#endif
+    for (; i < count; i++) accumulate_one(&vel[i], dt, &out_steps[2 * i]);
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+// Rect offsets and sizes of two neighbouring colliders, as x, y, x, y lanes.
+static inline __m128 bounce_offsets(const Collider *col) {
+    return _mm_movelh_ps(_mm_loadu_ps(&col[0].shape.as.rect.offset.x), _mm_loadu_ps(&col[1].shape.as.rect.offset.x));
+}
+
+static inline __m128 bounce_sizes(const Collider *col) {
+    return _mm_movehl_ps(_mm_loadu_ps(&col[1].shape.as.rect.offset.x), _mm_loadu_ps(&col[0].shape.as.rect.offset.x));
+}
+
+// bounce_one() for two entities.
+static inline void bounce_pair(Position *pos, Velocity *vel, const Collider *col, const __m128 min_v, const __m128 max_v) {
+    const __m128 p     = _mm_loadu_ps(&pos[0].x);
+    const __m128 lo    = _mm_add_ps(p,  bounce_offsets(col));
+    const __m128 hi    = _mm_add_ps(lo, bounce_sizes(col));
+    const __m128 under = _mm_cmplt_ps(lo, min_v);
+    const __m128 over  = _mm_cmpgt_ps(hi, max_v);
+    if (_mm_movemask_ps(_mm_or_ps(under, over)) == 0) return;
+    const __m128 push  = _mm_and_ps(under, _mm_sub_ps(min_v, lo));
+    const __m128 pull  = _mm_and_ps(over,  _mm_sub_ps(hi, max_v));
+    _mm_storeu_ps(&pos[0].x, _mm_sub_ps(_mm_add_ps(p, push), pull));
+
+    const __m128 zero  = _mm_setzero_ps();
+    const __m128 sign  = _mm_set1_ps(-0.0f);
+    const __m128 v0    = _mm_loadu_ps(&vel[0].value.x);
+    const __m128 v1    = _mm_loadu_ps(&vel[1].value.x);
+    __m128       value = _mm_movelh_ps(v0, v1);
+    value = _mm_xor_ps(value, _mm_and_ps(_mm_and_ps(under, _mm_cmplt_ps(value, zero)), sign));
+    value = _mm_xor_ps(value, _mm_and_ps(_mm_and_ps(over,  _mm_cmpgt_ps(value, zero)), sign));
+    _mm_storeu_ps(&vel[0].value.x, _mm_shuffle_ps(value, v0, _MM_SHUFFLE(3, 2, 1, 0)));
+    _mm_storeu_ps(&vel[1].value.x, _mm_shuffle_ps(value, v1, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+#endif
+
+// Two entities per step on every vector target: the rects have to be gathered
+// from Colliders one at a time anyway, so 8-wide AVX2 buys nothing here.
+// Nearly everything is inside the bounds on any given tick, so entities that
+// are get no stores at all; the SSE body checks four per branch.
+// The left/top and right/bottom flips run one after the other like the scalar
+// code, so a rect wider than the bounds ends up with the same velocity.
+void motion_bounce(Position *pos, Velocity *vel, const Collider *col, const uint32_t count, const Bounds bounds) {
+    uint32_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const float  right  = bounds.x + bounds.width;
+    const float  bottom = bounds.y + bounds.height;
+    const __m128 min_v  = _mm_setr_ps(bounds.x, bounds.y, bounds.x, bounds.y);
+    const __m128 max_v  = _mm_setr_ps(right, bottom, right, bottom);
+    for (; i + 4 <= count; i += 4) {
+        // Four inside, the common case, costs one branch and no stores.
+        const __m128 lo_a = _mm_add_ps(_mm_loadu_ps(&pos[i].x), bounce_offsets(&col[i]));
+        const __m128 lo_b = _mm_add_ps(_mm_loadu_ps(&pos[i + 2].x), bounce_offsets(&col[i + 2]));
+        const __m128 out_a = _mm_or_ps(_mm_cmplt_ps(lo_a, min_v), _mm_cmpgt_ps(_mm_add_ps(lo_a, bounce_sizes(&col[i])), max_v));
+        const __m128 out_b = _mm_or_ps(_mm_cmplt_ps(lo_b, min_v), _mm_cmpgt_ps(_mm_add_ps(lo_b, bounce_sizes(&col[i + 2])), max_v));
+        if (_mm_movemask_ps(_mm_or_ps(out_a, out_b)) == 0) continue;
+        bounce_pair(&pos[i],     &vel[i],     &col[i],     min_v, max_v);
+        bounce_pair(&pos[i + 2], &vel[i + 2], &col[i + 2], min_v, max_v);
+    }
+    for (; i + 2 <= count; i += 2) bounce_pair(&pos[i], &vel[i], &col[i], min_v, max_v);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float       right      = bounds.x + bounds.width;
+    const float       bottom     = bounds.y + bounds.height;
+    const float       min_xy[4]  = { bounds.x, bounds.y, bounds.x, bounds.y };
+    const float       max_xy[4]  = { right, bottom, right, bottom };
+    const float32x4_t min_v      = vld1q_f32(min_xy);
+    const float32x4_t max_v      = vld1q_f32(max_xy);
+    const float32x4_t zero       = vdupq_n_f32(0.0f);
+    for (; i + 2 <= count; i += 2) {
+        const float32x4_t rect0 = vld1q_f32(&col[i    ].shape.as.rect.offset.x);
+        const float32x4_t rect1 = vld1q_f32(&col[i + 1].shape.as.rect.offset.x);
+        const float32x4_t p     = vld1q_f32(&pos[i].x);
+        const float32x4_t lo    = vaddq_f32(p,  vcombine_f32(vget_low_f32 (rect0), vget_low_f32 (rect1)));
+        const float32x4_t hi    = vaddq_f32(lo, vcombine_f32(vget_high_f32(rect0), vget_high_f32(rect1)));
+        const uint32x4_t  under = vcltq_f32(lo, min_v);
+        const uint32x4_t  over  = vcgtq_f32(hi, max_v);
+        if (vmaxvq_u32(vorrq_u32(under, over)) == 0) continue;
+        const float32x4_t push  = vbslq_f32(under, vsubq_f32(min_v, lo), zero);
+        const float32x4_t pull  = vbslq_f32(over,  vsubq_f32(hi, max_v), zero);
+        vst1q_f32(&pos[i].x, vsubq_f32(vaddq_f32(p, push), pull));
+
+        float32x4_t value = vcombine_f32(vld1_f32(&vel[i].value.x), vld1_f32(&vel[i + 1].value.x));
+        value = vbslq_f32(vandq_u32(under, vcltq_f32(value, zero)), vnegq_f32(value), value);
+        value = vbslq_f32(vandq_u32(over,  vcgtq_f32(value, zero)), vnegq_f32(value), value);
+        vst1_f32(&vel[i    ].value.x, vget_low_f32 (value));
+        vst1_f32(&vel[i + 1].value.x, vget_high_f32(value));
+    }
+#endif
+    for (; i < count; i++) bounce_one(&pos[i], &vel[i], &col[i], bounds);
+}
@@ -0,0 +1,29 @@
+#ifndef MOTION_KERNELS_H
+#define MOTION_KERNELS_H
+
+#include "shared/ecs_world.h"
+
+#include <stdint.h>
+
+// Bulk motion math over `count` consecutive components, as handed out by
+// world_iter_next_run(). Each kernel has an AVX2 / SSE2 / NEON body picked at
+// compile time and a scalar loop for the tail and for other targets; all of
+// them give the same results as the per-entity code they replace.
+//
+// Positions and velocity values are interleaved x, y pairs, which the vector
+// bodies treat as lanes: both axes get the same math, so no x[] / y[] split is
+// needed, and the remainder half of each Velocity is shuffled out of the way.
+
+// pos += vel.value * dt
+void motion_integrate(Position *pos, const Velocity *vel, uint32_t count, float dt);
+
+// Sub-pixel accumulation, move_step_dt()'s first half: total = remainder +
+// value * dt, out_steps[2i], out_steps[2i + 1] get total truncated towards
+// zero, the fraction goes back into the remainder.
+void motion_accumulate(Velocity *vel, uint32_t count, float dt, int32_t *out_steps);
+
+// Pushes each collider's rect back inside `bounds` and turns the velocity
+// around on every axis it left through, sys_bounce_in_bounds() per entity.
+void motion_bounce(Position *pos, Velocity *vel, const Collider *col, uint32_t count, Bounds bounds);
+
+#endif //MOTION_KERNELS_H
@@ -1,6 +1,9 @@
 #include "game/movement.h"
+#include "game/motion_kernels.h"
+#include "game/collision/broadphase.h"
 #include "game/collision/collision.h"
 #include "game/collision/collision_query.h"
+#include "shared/array.h"
 
 #include "raymath.h"
 
@@ -8,19 +11,26 @@ typedef enum { AXIS_X, AXIS_Y } Axis;
 
 static int sign_i(const int value) { return (value > 0) - (value < 0); }
 
-static bool already_hit(const MoveResult *result, const EntityId entity_id) {
-    for (int i = 0; i < result->hits_count; i++) {
-        if (result->hits[i] == entity_id) return true;
+// Every hit a move has answered, for already_hit() and the sweeps' ignore
+// list; MoveResult.hits only keeps the first few for the caller. On the
+// mover's scratch, or over MoveResult.hits itself when there is none.
+typedef ARRAY(EntityId) EntityIdArray;
+
+static bool already_hit(const EntityIdArray *handled, const EntityId entity_id) {
+    for (uint32_t i = 0; i < handled->count; i++) {
+        if (handled->items[i] == entity_id) return true;
     }
     return false;
 }
 
-static void record_hit(MoveResult *result, const EntityId entity_id) {
+static void record_hit(MoveResult *result, EntityIdArray *handled, const EntityId entity_id) {
     const int capacity = (int)(sizeof result->hits / sizeof result->hits[0]);
     if (result->hits_count < capacity) {
         result->hits[result->hits_count] = entity_id;
         result->hits_count++;
     }
+    if (!handled->arena) handled->count = (uint32_t)result->hits_count;
+    else                 (void)ARRAY_PUSH(handled, entity_id); // scratch full: answered again, as over hits[]
 }
 
 static void move_axis_pixels(
@@ -32,22 +42,39 @@ static void move_axis_pixels(
     const Axis         axis,
     const int          delta_px,
     const MoveOptions *opts,
-    MoveResult        *result
+    MoveResult        *result,
+    EntityIdArray     *handled
 ) {
     if (delta_px == 0) return;
     const int dir = sign_i(delta_px);
     int remaining = (delta_px < 0) ? -delta_px : delta_px;
 
+    // One-pixel step in move direction
+    const Vector2 offset = (axis == AXIS_X)
+        ? (Vector2){ (float)dir, 0.0f }
+        : (Vector2){ 0.0f, (float)dir };
+    // Slide-up probes on any hit, handled before or not.
+    const bool slides = (axis == AXIS_X && opts->max_slide_up > 0);
+
     while (remaining > 0) {
-        // One-pixel step in move direction
-        const Vector2 offset = (axis == AXIS_X)
-            ? (Vector2){ (float)dir, 0.0f }
-            : (Vector2){ 0.0f, (float)dir };
+        // Jump straight to the next pixel the walk below would have to
+        // answer; every pixel before it just moves. Handlers can change the
+        // world, so the sweep starts over after each such pixel.
+        const int clear = collide_sweep_pos(world, *pos, col, exclude_id, offset, remaining, col->collides_with,
+                                            handled->items, slides ? 0 : (int)handled->count);
+        if (clear > 0) {
+            pos->x += offset.x * (float)clear;
+            pos->y += offset.y * (float)clear;
+            if (axis == AXIS_X) result->applied.x += (float)(dir * clear);
+            else                result->applied.y += (float)(dir * clear);
+            remaining -= clear;
+            if (remaining == 0) break;
+        }
 
         EntityId hit = ENTITY_NONE;
         if (collide_first_at_pos(world, *pos, col, exclude_id, offset, col->collides_with, &hit)) {
             // Slide-up: only on X, only if option is set (in raylib -Y is up)
-            if (axis == AXIS_X && opts->max_slide_up > 0) {
+            if (slides) {
                 for (int step_up = 1; step_up <= opts->max_slide_up; step_up++) {
                     const Vector2 probe = (Vector2){ (float)dir, -(float)step_up };
                     if (!collide_would_collide_pos(world, *pos, col, exclude_id, probe, col->collides_with)) {
@@ -58,18 +85,17 @@ static void move_axis_pixels(
                 }
             }
 
-            if (hit != ENTITY_NONE) {
-                // Already-handled hits keep blocking/passing by the same rule.
-                // In practice every non-STOP response means "keep moving and stop
-                // bothering us", so it's safe to just consume the pixel and continue;
-                if (already_hit(result, hit)) {
-                    pos->x += offset.x;
-                    pos->y += offset.y;
-                    if (axis == AXIS_X) result->applied.x += dir;
-                    else                result->applied.y += dir;
-                    remaining--;
-                    continue;
-                }
+            // Slid up clear of it: nothing left to answer, take the pixel.
+            // Already-handled hits keep blocking/passing by the same rule.
+            // In practice every non-STOP response means "keep moving and stop
+            // bothering us", so it's safe to just consume the pixel and continue;
+            if (hit == ENTITY_NONE || already_hit(handled, hit)) {
+                pos->x += offset.x;
+                pos->y += offset.y;
+                if (axis == AXIS_X) result->applied.x += dir;
+                else                result->applied.y += dir;
+                remaining--;
+                continue;
             }
 
             CollisionResponse response;
@@ -92,7 +118,7 @@ static void move_axis_pixels(
                 response = collide_handlers_dispatch(world, &ctx);
             }
 
-            record_hit(result, hit);
+            record_hit(result, handled, hit);
 
             if (collide_resp_stops_velocity(response)) {
                 if (axis == AXIS_X) { result->stopped_velocity_x = true; if (vel) vel->value.x = 0; }
@@ -131,9 +157,24 @@ void move_step_pixels(
     const MoveOptions *opts,
     MoveResult        *out_result
 ) {
+    const Position start = *pos;
     *out_result = (MoveResult){0};
-    move_axis_pixels(world, pos, vel, col, exclude_id, AXIS_X, dx, opts, out_result);
-    move_axis_pixels(world, pos, vel, col, exclude_id, AXIS_Y, dy, opts, out_result);
+
+    EntityIdArray handled = (EntityIdArray){ .items = out_result->hits };
+    ArenaMark     mark    = (ArenaMark){0};
+    if (opts->scratch) {
+        mark = arena_mark(opts->scratch);
+        ARRAY_INIT(&handled, opts->scratch, 16, ARENA_TAG_COLLISION);
+    }
+    move_axis_pixels(world, pos, vel, col, exclude_id, AXIS_X, dx, opts, out_result, &handled);
+    move_axis_pixels(world, pos, vel, col, exclude_id, AXIS_Y, dy, opts, out_result, &handled);
+    if (opts->scratch) arena_restore(mark);
+
+    // Refile real movers so the queries after this one see where they went.
+    // Hypothetical movers step a copy of the position, even with a real id.
+    if (world->broadphase && exclude_id != ENTITY_NONE && pos == world_get_position(world, exclude_id)) {
+        broadphase_move(world->broadphase, exclude_id, col, start, *pos);
+    }
 }
 
 void move_step_dt(
@@ -147,17 +188,13 @@ void move_step_dt(
     MoveResult        *out_result
 ) {
     // Accumulate intended motion (sub-pixel) into the remainder, extract
-    // integer pixels, stash the fraction back. truncf() is symmetric around
+    // integer pixels, stash the fraction back. Truncation is symmetric around
     // zero, important so that decelerating-and-reversing motion doesn't
     // round biased.
-    const float total_x = vel->remainder.x + vel->value.x * dt;
-    const float total_y = vel->remainder.y + vel->value.y * dt;
-    const int   dx      = (int)truncf(total_x);
-    const int   dy      = (int)truncf(total_y);
-    vel->remainder.x    = total_x - (float)dx;
-    vel->remainder.y    = total_y - (float)dy;
-
-    move_step_pixels(world, pos, vel, col, exclude_id, dx, dy, opts, out_result);
+    int32_t step[2];
+    motion_accumulate(vel, 1, dt, step);
+
+    move_step_pixels(world, pos, vel, col, exclude_id, step[0], step[1], opts, out_result);
 }
 
 MoveResult move_with_collision(World *world, const EntityId mover, const float dt, const MoveOptions *opts) {
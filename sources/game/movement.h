@@ -15,8 +15,9 @@ typedef struct {
 } MoveResult;
 
 typedef struct {
-    int  max_slide_up; // X-axis only, 0 disables
-    bool skip_handlers; // true == bypass handler chain, use default response (for computer controlled planning)
+    int    max_slide_up;  // X-axis only, 0 disables
+    bool   skip_handlers; // true == bypass handler chain, use default response (for computer controlled planning)
+    Arena *scratch;       // the calling worker's; without it a step stops remembering hits after hits[8]
 } MoveOptions;
 
 // Lowest-level primitive: walk dx pixels on X, then dy on Y.
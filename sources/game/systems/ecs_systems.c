@@ -57,30 +57,29 @@ static void emit_render_instance(
 void extract_render_snapshot(World *world, const Assets *assets, RenderSnapshot *out) {
     out->count = 0;
 
-    for (int i = 0; i < world->num_entities && out->count < MAX_RENDER_INSTANCES; i++) {
-        if (!world->alive[i])               continue;
-        if (!world->positions  .present[i]) continue;
-        if (!world->renderables.present[i]) continue;
+    const QueryId query = world_query_cached(world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_RENDERABLE), 0);
 
-        const EntityId    entity = (EntityId)i;
-        const Position   *pos    = world_get_position(world, entity);
-        const Renderable *render = world_get_renderable(world, entity);
+    WorldIter it = world_iter(world, query);
+    while (out->count < MAX_RENDER_INSTANCES && world_iter_next(&it)) {
+        const EntityId    entity = it.entity;
+        const Position   *pos    = it.components[COMPONENT_POSITION];
+        const Renderable *render = it.components[COMPONENT_RENDERABLE];
 
-        TextureId texture_id      = TEX_NONE;
-        Rectangle tex_source_rect = (Rectangle){0};
-        if (world->tex_regions.present[i]) {
-            const TexRegion *region = &world->tex_regions.data[i];
+        TextureId        texture_id      = TEX_NONE;
+        Rectangle        tex_source_rect = (Rectangle){0};
+        const TexRegion *region          = world_get_tex_region(world, entity);
+        const Animator  *anim            = world_get_animator(world, entity);
+        if (region) {
             texture_id      = region->texture_id;
             tex_source_rect = region->tex_source_rect;
-        } else if (world->animators.present[i]) {
-            const Animator *anim = &world->animators.data[i];
+        } else if (anim) {
             if (anim->frames.count == 0 || !anim->frames.regions) continue;
 
             const TexRegion frame = anim->frames.regions[anim->current_frame];
             texture_id      = frame.texture_id;
             tex_source_rect = frame.tex_source_rect;
         }
-        emit_render_instance(out, assets, (EntityId)i, pos, render, texture_id, tex_source_rect);
+        emit_render_instance(out, assets, entity, pos, render, texture_id, tex_source_rect);
     }
 
     // Sort RenderInstance's by layer, ascending. Higher layer draws on top.
@@ -6,9 +6,17 @@
 void sys_animation         (World *world, float dt);
 void sys_bounce_in_bounds  (World *world, Bounds bounds);
 void sys_integrate_velocity(World *world, float dt);
-void sys_move_platformer   (World *world, float dt);
+void sys_move_platformer   (World *world, Arena *scratch, float dt); // scratch: the worker's, see SCRATCH_ARENA_BYTES
 void sys_scale_return      (World *world, float dt);
 
+// The same systems over matches [begin, end) of their cached query, for
+// splitting one system across workers (see ecs_schedule.h). Only the systems
+// that touch nothing but the matched entity's own components have one.
+void sys_animation_range         (World *world, float dt, uint32_t begin, uint32_t end);
+void sys_bounce_in_bounds_range  (World *world, Bounds bounds, uint32_t begin, uint32_t end);
+void sys_integrate_velocity_range(World *world, float dt, uint32_t begin, uint32_t end);
+void sys_scale_return_range      (World *world, float dt, uint32_t begin, uint32_t end);
+
 void extract_render_snapshot(World *world, const Assets *assets, RenderSnapshot *out);
 
 #endif //SYSTEMS_H
@@ -1,12 +1,13 @@
 #include "ecs_systems.h"
 
 void sys_animation(World *world, const float dt) {
-    for (int i = 0; i < world->num_entities; i++) {
-        if (!world->alive[i])               continue;
-        if (!world->animators  .present[i]) continue;
+    sys_animation_range(world, dt, 0, UINT32_MAX);
+}
 
-        const EntityId entity_id = (EntityId)i;
-        Animator  *anim       = world_get_animator(world, entity_id);
+void sys_animation_range(World *world, const float dt, const uint32_t begin, const uint32_t end) {
+    WorldIter it = world_iter_range(world, world_query_cached(world, COMPONENT_BIT(COMPONENT_ANIMATOR), 0), begin, end);
+    while (world_iter_next(&it)) {
+        Animator  *anim       = it.components[COMPONENT_ANIMATOR];
         const int  num_frames = anim->frames.count;
 
         anim->state_time += dt;
@@ -1,17 +1,16 @@
 #include "ecs_systems.h"
+#include "game/motion_kernels.h"
 
 void sys_integrate_velocity(World *world, const float dt) {
-    for (int i = 0; i < world->num_entities; i++) {
-        if (!world->alive[i])              continue;
-        if (!world->positions .present[i]) continue;
-        if (!world->velocities.present[i]) continue;
+    sys_integrate_velocity_range(world, dt, 0, UINT32_MAX);
+}
 
-        const EntityId entity_id = (EntityId)i;
-        Position       *pos =  world_get_position(world, entity_id);
-        const Velocity  vel = *world_get_velocity(world, entity_id);
+void sys_integrate_velocity_range(World *world, const float dt, const uint32_t begin, const uint32_t end) {
+    const QueryId query = world_query_cached(world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY), 0);
 
-        pos->x += vel.value.x * dt;
-        pos->y += vel.value.y * dt;
+    WorldIter it = world_iter_range(world, query, begin, end);
+    for (uint32_t rows; (rows = world_iter_next_run(&it)) > 0;) {
+        motion_integrate(it.components[COMPONENT_POSITION], it.components[COMPONENT_VELOCITY], rows, dt);
     }
 }
 
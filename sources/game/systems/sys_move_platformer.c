@@ -6,6 +6,7 @@
 // and never touch the real entity.
 static void platformer_step(
     World          *world,
+    Arena          *scratch,
     const EntityId  mover_or_none, // ENTITY_NONE for hypothetical movement
     const float     dt,
     Position       *pos,
@@ -17,23 +18,25 @@ static void platformer_step(
     const MoveOptions opts = (MoveOptions){
         .max_slide_up  = move->slide_up_when_grounded,
         .skip_handlers = false,
+        .scratch       = scratch,
     };
     MoveResult result;
     move_step_dt(world, pos, vel, col, mover_or_none, dt, &opts, &result);
     (void)move; // TODO: ground/jump/grav bookkeeping
 }
 
-void sys_move_platformer(World *world, const float dt) {
-    for (int i = 0; i < world->num_entities; i++) {
-        if (!world->alive[i]) continue;
-        const EntityId entity_id = (EntityId)i;
+void sys_move_platformer(World *world, Arena *scratch, const float dt) {
+    const QueryId query = world_query_cached(world,
+        COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY) |
+        COMPONENT_BIT(COMPONENT_COLLIDER) | COMPONENT_BIT(COMPONENT_MOVE_PLATFORMER), 0);
 
-        Position       *pos  = world_get_position(world, entity_id);
-        Velocity       *vel  = world_get_velocity(world, entity_id);
-        const Collider *col  = world_get_collider(world, entity_id);
-        MovePlatformer *move = world_get_move_platformer(world, entity_id);
-        if (!pos || !vel || !col || !move) continue;
+    WorldIter it = world_iter(world, query);
+    while (world_iter_next(&it)) {
+        Position       *pos  = it.components[COMPONENT_POSITION];
+        Velocity       *vel  = it.components[COMPONENT_VELOCITY];
+        const Collider *col  = it.components[COMPONENT_COLLIDER];
+        MovePlatformer *move = it.components[COMPONENT_MOVE_PLATFORMER];
 
-        platformer_step(world, entity_id, dt, pos, vel, col, move);
+        platformer_step(world, scratch, it.entity, dt, pos, vel, col, move);
     }
 }
\ No newline at end of file
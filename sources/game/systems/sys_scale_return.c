@@ -1,12 +1,13 @@
 #include "ecs_systems.h"
 
 void sys_scale_return(World *world, const float dt) {
-    for (int i = 0; i < world->num_entities; i++) {
-        if (!world->alive[i])               continue;
-        if (!world->renderables.present[i]) continue;
+    sys_scale_return_range(world, dt, 0, UINT32_MAX);
+}
 
-        const EntityId entity_id = (EntityId)i;
-        Renderable *render = world_get_renderable(world, i);
+void sys_scale_return_range(World *world, const float dt, const uint32_t begin, const uint32_t end) {
+    WorldIter it = world_iter_range(world, world_query_cached(world, COMPONENT_BIT(COMPONENT_RENDERABLE), 0), begin, end);
+    while (world_iter_next(&it)) {
+        Renderable *render = it.components[COMPONENT_RENDERABLE];
         if (render->scale_settle_secs <= 0.0f) continue;
 
         const float ease = 1.0f - exp2f(-dt / render->scale_settle_secs);
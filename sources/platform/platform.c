@@ -4,6 +4,7 @@
 #include "game/game.h"
 #include "shared/assets.h"
 #include "shared/common.h"
+#include "shared/vmem.h"
 #include "raylib.h"
 #include "resource_dir.h"
 
@@ -35,9 +36,18 @@
 static char g_dll_built_path[1024];
 static int  g_load_counter = 0;
 
-// In BSS - zero-initialized, stable address across reloads. For a real
-// project, VirtualAlloc/mmap at a fixed base for full pointer stability.
-static GameMemory g_memory;
+// GameMemory and the arena behind it, reserved at a fixed base so every
+// pointer into them is the same across reloads and, when the OS grants the
+// base, across runs too. Pages are committed as the arena grows; the hot
+// arrays ask for transparent huge pages where the OS has them.
+#if UINTPTR_MAX > 0xFFFFFFFFu
+  #define GAME_MEMORY_BASE ((void *)(uintptr_t)0x200000000000ull) // 32 TB, clear of heap, stacks and libraries
+#else
+  #define GAME_MEMORY_BASE NULL
+#endif
+
+static GameMemory *g_memory;
+static size_t      g_memory_bytes;
 
 typedef struct {
     LibHandle handle;
@@ -98,6 +108,26 @@ static bool game_module_should_reload(const GameModule *m) {
     return mtime != 0 && mtime != m->built_mtime;
 }
 
+static GameMemory *game_memory_reserve(void) {
+    const size_t header = ((sizeof(GameMemory) + ARENA_COMMIT_BYTES - 1) & ~(size_t)(ARENA_COMMIT_BYTES - 1));
+    const size_t total  = header + GAME_ARENA_BYTES;
+
+    uint8_t *base = vmem_reserve(GAME_MEMORY_BASE, total);
+    if (!base) return NULL;
+    if (GAME_MEMORY_BASE && base != GAME_MEMORY_BASE) {
+        TraceLog(LOG_WARNING, "game memory: fixed base %p taken, reserved at %p", GAME_MEMORY_BASE, (void *)base);
+    }
+    if (!vmem_commit(base, header, true)) {
+        vmem_release(base, total);
+        return NULL;
+    }
+
+    GameMemory *memory = (GameMemory *)base;
+    arena_init_reserved(&memory->arena, base + header, GAME_ARENA_BYTES, true);
+    g_memory_bytes = total;
+    return memory;
+}
+
 static void gather_input(GameInput *in) {
     *in = (GameInput){0};
     in->key_left    = IsKeyDown(KEY_LEFT)  || IsKeyDown(KEY_A);
@@ -126,13 +156,27 @@ int main(void) {
 
     SearchAndSetResourceDir("resources");
 
+    g_memory = game_memory_reserve();
+    if (!g_memory) {
+        TraceLog(LOG_FATAL, "could not reserve game memory");
+        CloseWindow();
+        return 1;
+    }
+
+    // Worker threads run the platform's copy of the job system, so reloading
+    // the game module never pulls their entry point out from under them.
+    // One core is left to the main thread, which helps while it waits.
+    jobs_start(&g_memory->jobs, thread_cpu_count() - 1);
+
     GameModule game = {0};
     if (!game_module_load(&game)) {
         TraceLog(LOG_FATAL, "could not load game module: %s", g_dll_built_path);
+        jobs_stop(&g_memory->jobs);
+        vmem_release(g_memory, g_memory_bytes);
         CloseWindow();
         return 1;
     }
-    game.api.load(&g_memory);
+    game.api.load(g_memory);
 
     // ----- Gaffer's "Fix Your Timestep" w/interpolation -----
     // https://gafferongames.com/post/fix_your_timestep/
@@ -154,10 +198,10 @@ int main(void) {
             GameModule new_game = {0};
             if (game_module_load(&new_game)) {
                 // Success: tear down the old module and swap in the new
-                game.api.unload(&g_memory);
+                game.api.unload(g_memory);
                 game_module_unload(&game);
                 game = new_game;
-                game.api.load(&g_memory);
+                game.api.load(g_memory);
                 TraceLog(LOG_INFO, "game module reloaded");
             }
             // Failure: built_mtime unchanged → retry next frame.
@@ -167,24 +211,26 @@ int main(void) {
         gather_input(&input);
 
         // Hot reload: live update of modified assets
-        assets_poll_reload(&g_memory.assets, &g_memory.arena);
+        assets_poll_reload(&g_memory->assets);
 
         // Integrate at fixed dt as many times as the accumulator allows
         while (accumulator >= dt) {
-            game.api.update(&g_memory, &input, (float)dt);
+            game.api.update(g_memory, &input, (float)dt);
             accumulator -= dt;
         }
 
         // Remaining accumulator becomes the interpolation factor for rendering
         const float alpha = (float)(accumulator / dt);
-        game.api.render(&g_memory, alpha);
+        game.api.render(g_memory, alpha);
     }
 
     // Order matters: shutdown frees GPU/audio resources via raylib,
     // requires GL context to still be alive. CloseWindow destroys it.
-    game.api.shutdown(&g_memory);
-    game.api.unload(&g_memory);
+    game.api.shutdown(g_memory);
+    game.api.unload(g_memory);
     game_module_unload(&game);
+    jobs_stop(&g_memory->jobs);
+    vmem_release(g_memory, g_memory_bytes);
 
     CloseWindow();
     return 0;
@@ -1,4 +1,38 @@
 #include "shared/arena.h"
+#include "shared/vmem.h"
+#include "raylib.h"
+
+#include <stdio.h>
+
+void arena_init(Arena *arena, void *memory, const size_t capacity) {
+    *arena = (Arena){
+        .base      = memory,
+        .capacity  = capacity,
+        .committed = capacity,
+    };
+}
+
+void arena_init_reserved(Arena *arena, void *memory, const size_t capacity, const bool huge) {
+    *arena = (Arena){
+        .base     = memory,
+        .capacity = capacity,
+        .huge     = huge,
+    };
+}
+
+// Slow path of arena_alloc(): commit whole steps up to at least `end`.
+static bool arena_commit(Arena *arena, const size_t end) {
+    const size_t step = arena->huge ? VMEM_HUGE_PAGE_BYTES : ARENA_COMMIT_BYTES;
+    size_t target = (end + step - 1) & ~(step - 1);
+    if (target > arena->capacity) target = arena->capacity;
+
+    if (!vmem_commit(arena->base + arena->committed, target - arena->committed, arena->huge)) {
+        TraceLog(LOG_WARNING, "arena_commit(): could not commit %zu bytes", target - arena->committed);
+        return false;
+    }
+    arena->committed = target;
+    return true;
+}
 
 // Round `used` up to the next multiple of `align`.
 // Assumes align is a power of 2, which _Alignof guarantees for all standard C types.
@@ -10,11 +44,131 @@
 // Example, align = 8:
 //   used = 13:  (13 + 7) & ~7  =  20 & ~0b111  =  10100 & 11000  =  16   (rounded up)
 //   used = 16:  (16 + 7) & ~7  =  23 & ~0b111  =  10111 & 11000  =  16   (already aligned, unchanged)
-void *arena_alloc(Arena *arena, const size_t size, const size_t align) {
+void *arena_alloc_untagged(Arena *arena, const size_t size, const size_t align) {
     const size_t aligned = (arena->used + align - 1) & ~(align - 1);
-    if (aligned + size > ARENA_BYTES) return NULL;
+    if (aligned + size > arena->capacity) return NULL;
+    if (aligned + size > arena->committed && !arena_commit(arena, aligned + size)) return NULL;
 
-    void *p = arena->bytes + aligned;
+    void *p = arena->base + aligned;
     arena->used = aligned + size;
     return p;
 }
+
+#if ARENA_TELEMETRY
+// Charges `tag` with everything `used` moved since `before`, padding included,
+// so the tags of an arena add up to its `used`.
+static void arena_count(Arena *arena, const ArenaTag tag, const size_t before) {
+    ArenaTagStats *stats = &arena->tags[tag];
+    const size_t   bytes = arena->used - before;
+    stats->live  += bytes;
+    stats->total += bytes;
+    stats->count++;
+    if (stats->live > stats->peak) stats->peak = stats->live;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+}
+
+void *arena_alloc_tagged(Arena *arena, const size_t size, const size_t align, const ArenaTag tag) {
+    const size_t before = arena->used;
+    void        *p      = arena_alloc_untagged(arena, size, align);
+    if (p) arena_count(arena, tag, before);
+    return p;
+}
+#endif
+
+ArenaMark arena_mark(Arena *arena) {
+    ArenaMark mark = (ArenaMark){ .arena = arena, .used = arena->used };
+#if ARENA_TELEMETRY
+    for (int tag = 0; tag < ARENA_TAG_COUNT; tag++) mark.live[tag] = arena->tags[tag].live;
+#endif
+    return mark;
+}
+
+void arena_restore(const ArenaMark mark) {
+    mark.arena->used = mark.used;
+#if ARENA_TELEMETRY
+    for (int tag = 0; tag < ARENA_TAG_COUNT; tag++) mark.arena->tags[tag].live = mark.live[tag];
+#endif
+}
+
+void arena_reset(Arena *arena) {
+    arena->used = 0;
+#if ARENA_TELEMETRY
+    for (int tag = 0; tag < ARENA_TAG_COUNT; tag++) arena->tags[tag].live = 0;
+#endif
+}
+
+// A reserved parent only hands out address space, the sub-arena commits it,
+// so a 16 MB level arena costs nothing until the level fills it.
+Arena arena_sub(Arena *parent, const size_t capacity, const ArenaTag tag) {
+    Arena        sub     = {0};
+    const bool   lazy    = parent->committed < parent->capacity;
+    const size_t align   = lazy ? ARENA_COMMIT_BYTES : ARENA_BASE_ALIGN;
+    const size_t aligned = (parent->used + align - 1) & ~(align - 1);
+    if (aligned + capacity > parent->capacity) {
+        TraceLog(LOG_WARNING, "arena_sub(): %zu bytes requested, %zu of %zu in use", capacity, parent->used, parent->capacity);
+        return sub;
+    }
+#if ARENA_TELEMETRY
+    const size_t before = parent->used;
+    parent->used = aligned + capacity;
+    arena_count(parent, tag, before);
+#else
+    (void)tag;
+    parent->used = aligned + capacity;
+#endif
+
+    if (lazy) arena_init_reserved(&sub, parent->base + aligned, capacity, parent->huge);
+    else      arena_init         (&sub, parent->base + aligned, capacity);
+    return sub;
+}
+
+// ----------------------------------------------------------------------------
+// Telemetry
+// ----------------------------------------------------------------------------
+
+#if ARENA_TELEMETRY
+static const char *const ARENA_TAG_NAMES[ARENA_TAG_COUNT] = {
+#define ARENA_TAG_NAME(tag, name) [ARENA_TAG_##tag] = name,
+    ARENA_TAGS(ARENA_TAG_NAME)
+#undef ARENA_TAG_NAME
+};
+
+const char *arena_tag_name(const ArenaTag tag) {
+    return (unsigned)tag < ARENA_TAG_COUNT ? ARENA_TAG_NAMES[tag] : "?";
+}
+
+void arena_telemetry_tick(Arena *arena, const double seconds) {
+    if (seconds - arena->window_start < 60.0) return;
+
+    const double minutes = (seconds - arena->window_start) / 60.0;
+    for (int tag = 0; tag < ARENA_TAG_COUNT; tag++) {
+        ArenaTagStats *stats = &arena->tags[tag];
+        stats->growth      = ((double)stats->live - (double)stats->window_live) / minutes;
+        stats->window_live = stats->live;
+    }
+    arena->window_start = seconds;
+}
+
+bool arena_telemetry_dump(const char *path, const Arena *const arenas[], const char *const names[], const int count) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        TraceLog(LOG_WARNING, "arena_telemetry_dump(): can't write %s", path);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const Arena *arena = arenas[i];
+        fprintf(file, "%s: used %zu, peak %zu, committed %zu, reserved %zu\n",
+                names[i], arena->used, arena->peak, arena->committed, arena->capacity);
+        fprintf(file, "  %-10s %12s %12s %12s %10s %14s\n", "tag", "live", "peak", "total", "allocs", "growth/min");
+        for (int tag = 0; tag < ARENA_TAG_COUNT; tag++) {
+            const ArenaTagStats *stats = &arena->tags[tag];
+            if (stats->count == 0) continue;
+            fprintf(file, "  %-10s %12zu %12zu %12zu %10zu %+14.0f\n",
+                    ARENA_TAG_NAMES[tag], stats->live, stats->peak, stats->total, stats->count, stats->growth);
+        }
+    }
+    fclose(file);
+    return true;
+}
+#endif
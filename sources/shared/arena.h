@@ -1,18 +1,122 @@
 #ifndef ARENA_H
 #define ARENA_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-#define ARENA_BYTES (64 * 1024 * 1024)
+#define ARENA_BYTES        (64 * 1024 * 1024) // for arenas over plain static or heap memory
+#define ARENA_COMMIT_BYTES (64 * 1024)        // reserved arenas commit in steps of this
 
+// Per-subsystem accounting, on with -DARENA_TELEMETRY=1 (the CMake option of
+// the same name). Every allocation names its subsystem; with telemetry off
+// the tag is dropped by the macros below and nothing is counted or stored.
+#ifndef ARENA_TELEMETRY
+  #define ARENA_TELEMETRY 0
+#endif
+
+//   X(TAG, "name") -> ARENA_TAG_TAG, arena_tag_name()
+#define ARENA_TAGS(X)               \
+    X(UNTAGGED,  "untagged")        \
+    X(ASSETS,    "assets")          \
+    X(ANIMATION, "animation")       \
+    X(TILEMAP,   "tilemap")         \
+    X(ECS,       "ecs")             \
+    X(COMMANDS,  "commands")        \
+    X(COLLISION, "collision")       \
+    X(LEVEL,     "level")           \
+    X(SCRATCH,   "scratch")
+
+typedef enum {
+#define ARENA_TAG_ENUM(tag, name) ARENA_TAG_##tag,
+    ARENA_TAGS(ARENA_TAG_ENUM)
+#undef ARENA_TAG_ENUM
+    ARENA_TAG_COUNT,
+} ArenaTag;
+
+#if ARENA_TELEMETRY
+typedef struct {
+    size_t   live;          // bytes allocated and not yet given back by a restore or reset
+    size_t   peak;          // highest `live`
+    size_t   total;         // bytes ever allocated, alignment padding included
+    size_t   count;         // allocations ever made
+    double   growth;        // change in `live` over the last full minute, bytes
+    size_t   window_live;   // `live` when the current minute started
+} ArenaTagStats;
+#endif
+
+// Bump allocator over memory it doesn't own: a reservation made by the
+// platform for the root arena, a block of the parent for a sub-arena, or any
+// plain buffer. Nothing is freed one allocation at a time; give space back
+// with a mark, a reset, or by dropping the sub-arena it came from.
 typedef struct {
-    uint8_t  bytes[ARENA_BYTES];
+    uint8_t *base;
+    size_t   capacity;  // bytes reserved
     size_t   used;
+    size_t   committed; // bytes usable without asking the OS; == capacity for arena_init()
+    bool     huge;      // commit in huge-page steps, for arenas holding hot arrays
+#if ARENA_TELEMETRY
+    size_t         peak;         // highest `used`
+    double         window_start; // seconds, see arena_telemetry_tick()
+    ArenaTagStats  tags[ARENA_TAG_COUNT];
+#endif
 } Arena;
 
-void *arena_alloc(Arena *arena, size_t size, size_t align);
+typedef struct {
+    Arena   *arena;
+    size_t   used;
+#if ARENA_TELEMETRY
+    size_t   live[ARENA_TAG_COUNT];
+#endif
+} ArenaMark;
+
+// Alignment is computed from `used`, so `memory` should sit on an
+// ARENA_BASE_ALIGN boundary for the pointers handed out to be aligned too.
+#define ARENA_BASE_ALIGN 64
+
+void  arena_init (Arena *arena, void *memory, size_t capacity);
+
+// Over address space from vmem_reserve(): pages are committed as allocations
+// reach them and stay committed through restores and resets. `memory` must be
+// ARENA_COMMIT_BYTES aligned.
+void  arena_init_reserved(Arena *arena, void *memory, size_t capacity, bool huge);
+
+// arena_alloc(arena, size, align, tag), NULL when the arena is full.
+void *arena_alloc_untagged(Arena *arena, size_t size, size_t align);
+#if ARENA_TELEMETRY
+void *arena_alloc_tagged(Arena *arena, size_t size, size_t align, ArenaTag tag);
+  #define arena_alloc(arena, size, align, tag) arena_alloc_tagged((arena), (size), (align), (tag))
+#else
+  #define arena_alloc(arena, size, align, tag) arena_alloc_untagged((arena), (size), (align))
+#endif
+
+// Everything allocated after the mark is released by restoring it, including
+// sub-arenas carved since.
+ArenaMark arena_mark   (Arena *arena);
+void      arena_restore(ArenaMark mark);
+void      arena_reset  (Arena *arena);
+
+// Carves `capacity` bytes out of `parent` as an arena of its own, e.g. one per
+// level, reset on level change without touching what the parent allocated
+// before it. Lives as long as the parent's allocation: a restore or reset of
+// the parent that covers it drops it too. An arena with no capacity (every
+// alloc returns NULL) when the parent is full. Carved from a reserved arena,
+// it commits its own pages lazily. The parent counts the block under `tag`.
+Arena arena_sub(Arena *parent, size_t capacity, ArenaTag tag);
+
+#define ARENA_NEW_ARRAY(arena, type, count, tag) \
+    ((type*)arena_alloc((arena), sizeof(type) * (count), _Alignof(type), (tag)))
+
+#if ARENA_TELEMETRY
+const char *arena_tag_name(ArenaTag tag);
+
+// Call about once a tick with a steadily increasing clock: every 60 seconds
+// it turns each tag's change in `live` into ArenaTagStats.growth.
+void arena_telemetry_tick(Arena *arena, double seconds);
 
-#define ARENA_NEW_ARRAY(arena, type, count) \
-    ((type*)arena_alloc((arena), sizeof(type) * (count), _Alignof(type)))
+// Writes a per-tag table for each arena, `names` labelling them. False if
+// the file can't be written.
+bool arena_telemetry_dump(const char *path, const Arena *const arenas[], const char *const names[], int count);
+#endif
 
 #endif //ARENA_H
@@ -0,0 +1,29 @@
+#include "shared/array.h"
+
+#include <string.h>
+
+bool array_reserve_raw(void **items, uint32_t *capacity, const uint32_t needed, const size_t item_size,
+                       Arena *arena, const ArenaTag tag) {
+    (void)tag;
+    if (needed <= *capacity) return true;
+
+    uint32_t grown = *capacity > 0 ? *capacity : ARRAY_MIN_CAPACITY;
+    while (grown < needed) grown = grown > UINT32_MAX / 2 ? needed : grown * 2;
+
+    const size_t old_bytes = (size_t)*capacity * item_size;
+    const size_t new_bytes = (size_t)grown     * item_size;
+
+    // Newest allocation in the arena: just take the bytes right after it.
+    if (*items && (uint8_t *)*items + old_bytes == arena->base + arena->used) {
+        if (!arena_alloc(arena, new_bytes - old_bytes, 1, tag)) return false;
+        *capacity = grown;
+        return true;
+    }
+
+    void *moved = arena_alloc(arena, new_bytes, _Alignof(max_align_t), tag);
+    if (!moved) return false;
+    if (old_bytes > 0) memcpy(moved, *items, old_bytes);
+    *items    = moved;
+    *capacity = grown;
+    return true;
+}
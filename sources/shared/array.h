@@ -0,0 +1,65 @@
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include "shared/arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Growable array over an Arena. Declare a type per element type and keep it
+// anywhere, GameMemory included: it is plain data holding only arena
+// pointers, so it survives module reloads as long as its arena does.
+//
+//   typedef ARRAY(EntityId) EntityIdArray;
+//   EntityIdArray ids;
+//   ARRAY_INIT(&ids, &m->level_arena, 64, ARENA_TAG_LEVEL);
+//   if (!ARRAY_PUSH(&ids, id)) ...; // arena full
+//
+// Growing doubles the capacity. When the items are the arena's newest
+// allocation they are extended in place; otherwise they move and the old
+// block stays behind until the arena is reset, so size `capacity` up front
+// when you can. Items are aligned to max_align_t. Not thread-safe.
+#define ARRAY_MIN_CAPACITY 16
+
+#define ARRAY(type)          \
+    struct {                 \
+        type     *items;     \
+        uint32_t  count;     \
+        uint32_t  capacity;  \
+        Arena    *arena;     \
+        ArenaTag  tag;       \
+    }
+
+// Makes room for `needed` items in total. False, with the array untouched,
+// when the arena is full.
+bool array_reserve_raw(void **items, uint32_t *capacity, uint32_t needed, size_t item_size, Arena *arena, ArenaTag tag);
+
+#define ARRAY_INIT(array, arena_, capacity_, tag_)                                         \
+    do {                                                                                   \
+        (array)->items    = NULL;                                                          \
+        (array)->count    = 0;                                                             \
+        (array)->capacity = 0;                                                             \
+        (array)->arena    = (arena_);                                                      \
+        (array)->tag      = (tag_);                                                        \
+        (void)array_reserve_raw((void **)&(array)->items, &(array)->capacity, (capacity_), \
+                                sizeof *(array)->items, (array)->arena, (array)->tag);     \
+    } while (0)
+
+#define ARRAY_RESERVE(array, needed)                                                       \
+    ((needed) <= (array)->capacity ||                                                      \
+     array_reserve_raw((void **)&(array)->items, &(array)->capacity, (needed),             \
+                       sizeof *(array)->items, (array)->arena, (array)->tag))
+
+// Appends `value`. False when the arena is full.
+#define ARRAY_PUSH(array, value) \
+    (ARRAY_RESERVE((array), (array)->count + 1) ? ((array)->items[(array)->count++] = (value), true) : false)
+
+#define ARRAY_POP(array)   ((array)->items[--(array)->count])
+#define ARRAY_LAST(array)  ((array)->items[(array)->count - 1])
+#define ARRAY_CLEAR(array) ((array)->count = 0)
+
+// O(1) removal that moves the last item into slot `index`; order is not kept.
+#define ARRAY_REMOVE_SWAP(array, index) ((array)->items[(index)] = (array)->items[--(array)->count])
+
+#endif //ARRAY_H
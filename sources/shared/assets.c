@@ -69,7 +69,7 @@ static bool parse_rtpa(Atlas *atlas, const char *text, Arena *arena) {
             int  w, h, count, is_font, fsize;
             if (sscanf(line, "a %127s %d %d %d %d %d",
                        img, &w, &h, &count, &is_font, &fsize) == 6) {
-                atlas->sprites      = ARENA_NEW_ARRAY(arena, AtlasSprite, count);
+                atlas->sprites      = ARENA_NEW_ARRAY(arena, AtlasSprite, count, ARENA_TAG_ASSETS);
                 atlas->sprite_count = 0;
                 expected            = count;
                 if (!atlas->sprites) return false;
@@ -110,8 +110,10 @@ static bool parse_rtpa(Atlas *atlas, const char *text, Arena *arena) {
     return expected > 0 && atlas->sprite_count == expected;
 }
 
-// Commit-on-success wrapper around `parse_rtpa`
-static bool atlas_reload(Atlas *atlas, const char *path, Arena *arena) {
+// Commit-on-success wrapper around `parse_rtpa`. The new sprites are parsed
+// into the atlas arena after the live ones, which a failed reload leaves
+// alone, then slid down to the start so the arena never grows past one copy.
+static bool atlas_reload(Atlas *atlas, const char *path) {
     char *text = LoadFileText(path);
     if (!text) return false;
 
@@ -119,10 +121,21 @@ static bool atlas_reload(Atlas *atlas, const char *path, Arena *arena) {
     staging.sprite_count = 0;
     staging.mtime        = GetFileModTime(path);
 
-    const bool ok = parse_rtpa(&staging, text, arena);
+    const bool ok = parse_rtpa(&staging, text, &staging.arena);
     UnloadFileText(text);
 
     if (!ok) return false;
+    const AtlasSprite *parsed = staging.sprites;
+    arena_reset(&staging.arena);
+    staging.sprites = ARENA_NEW_ARRAY(&staging.arena, AtlasSprite, staging.sprite_count, ARENA_TAG_ASSETS);
+    memmove(staging.sprites, parsed, sizeof *parsed * (size_t)staging.sprite_count);
+
+    hash_map_init(&staging.by_name, &staging.arena, (uint32_t)staging.sprite_count, ARENA_TAG_ASSETS);
+    for (int i = 0; i < staging.sprite_count; i++) {
+        // First one wins, as with the scan in atlas_find_region().
+        const uint64_t key = hash_string(staging.sprites[i].name);
+        if (!hash_map_get(&staging.by_name, key, NULL)) hash_map_put(&staging.by_name, key, (uint32_t)i);
+    }
     *atlas = staging;
     return true;
 }
@@ -184,7 +197,8 @@ void assets_init(Assets *assets, Arena * arena) {
             continue;
         }
         assets->atlases[id].tex_id = ATLAS_IMAGES[id];
-        if (!atlas_reload(&assets->atlases[id], ATLAS_PATHS[id], arena)) {
+        assets->atlases[id].arena  = arena_sub(arena, ATLAS_ARENA_BYTES, ARENA_TAG_ASSETS);
+        if (!atlas_reload(&assets->atlases[id], ATLAS_PATHS[id])) {
             TraceLog(LOG_WARNING, "assets_init: missing atlas %s", ATLAS_PATHS[id]);
         } else {
             TraceLog(LOG_INFO, "assets_init: loaded atlas %s (%d sprites)",
@@ -193,7 +207,7 @@ void assets_init(Assets *assets, Arena * arena) {
     }
 }
 
-void assets_poll_reload(Assets *assets, Arena *arena) {
+void assets_poll_reload(Assets *assets) {
     // Scan all slots each frame. TEX_COUNT et al. are small.
     for (TextureId id = 1; id < TEX_COUNT; id++) {
         const char *path = TEXTURE_PATHS[id];
@@ -250,7 +264,7 @@ void assets_poll_reload(Assets *assets, Arena *arena) {
         const long now_mtime = GetFileModTime(path);
         if (now_mtime == 0 || now_mtime == assets->atlases[id].mtime) continue;
 
-        if (atlas_reload(&assets->atlases[id], path, arena)) {
+        if (atlas_reload(&assets->atlases[id], path)) {
             TraceLog(LOG_INFO, "reloaded atlas %s", path);
         } else {
             TraceLog(LOG_WARNING, "failed to reload atlas %s", path);
@@ -301,6 +315,13 @@ Font assets_get_font(const Assets *assets, const FontId    id) {
 
 TexRegion atlas_find_region(const Atlas *atlas, const char *region_name) {
     if (!atlas) return (TexRegion){0};
+
+    uint32_t index;
+    if (!hash_map_get(&atlas->by_name, hash_string(region_name), &index)) return (TexRegion){0};
+    if (strcmp(atlas->sprites[index].name, region_name) == 0) {
+        return (TexRegion){ atlas->tex_id, atlas->sprites[index].tex_source_rect };
+    }
+    // Another name with the same hash got the key first: scan.
     for (int i = 0; i < atlas->sprite_count; i++) {
         if (strcmp(atlas->sprites[i].name, region_name) == 0) {
             return (TexRegion){ atlas->tex_id, atlas->sprites[i].tex_source_rect };
@@ -314,7 +335,7 @@ AtlasRegions atlas_find_regions_by_tag(const Atlas *atlas, const char *tag, Aren
 
     const int          num_regions   = atlas_count_regions_by_tag(atlas, tag);
     const AtlasRegions atlas_regions = (AtlasRegions){
-        .regions = ARENA_NEW_ARRAY(arena, TexRegion, num_regions),
+        .regions = ARENA_NEW_ARRAY(arena, TexRegion, num_regions, ARENA_TAG_ANIMATION),
         .count   = num_regions,
     };
 
@@ -2,10 +2,12 @@
 #define ASSETS_H
 
 #include "shared/arena.h"
+#include "shared/hash_map.h"
 #include "raylib.h"
 
 #define ATLAS_NAME_LENGTH    32
 #define ATLAS_TAG_LENGTH     32
+#define ATLAS_ARENA_BYTES    (256 * 1024) // per atlas; a reload briefly holds old and new sprites
 
 typedef enum {
     ATLAS_NONE = 0,
@@ -42,9 +44,11 @@ typedef struct {
 typedef struct {
     const char  *path;
     TextureId    tex_id;  // which TextureId is the atlas image
-    AtlasSprite *sprites; // arena-owned
+    AtlasSprite *sprites; // in `arena`
     int          sprite_count;
+    HashMap      by_name; // hash_string(name) -> index into `sprites`, in `arena`
     long         mtime;
+    Arena        arena;   // the atlas's own, reused by every reload
 } Atlas;
 
 #define TEX_REGION_DEFAULTS .tex_source_rect = (Rectangle){ 0, 0, 0, 0 }
@@ -66,8 +70,8 @@ typedef struct {
     long        font_mtimes[FONT_COUNT];
 } Assets;
 
-void assets_init       (Assets *assets, Arena *arena);
-void assets_poll_reload(Assets *assets, Arena *arena);
+void assets_init       (Assets *assets, Arena *arena); // carves the atlases' arenas from `arena`
+void assets_poll_reload(Assets *assets);
 void assets_unload_all (Assets *assets);
 
 const Atlas *assets_get_atlas  (const Assets *assets, AtlasId   id);
@@ -0,0 +1,97 @@
+#include "shared/ecs_commands.h"
+
+#include <string.h>
+
+// Every payload starts on this boundary, enough for any component's _Alignof.
+#define COMMANDS_PAYLOAD_ALIGN 16
+
+void commands_init(CommandBuffer *buffer, Arena *arena) {
+    *buffer = (CommandBuffer){
+        .commands = ARENA_NEW_ARRAY(arena, Command,  COMMANDS_MAX, ARENA_TAG_COMMANDS),
+        .payload  = arena_alloc(arena, COMMANDS_PAYLOAD_SIZE, COMMANDS_PAYLOAD_ALIGN, ARENA_TAG_COMMANDS),
+        .created  = ARENA_NEW_ARRAY(arena, EntityId, COMMANDS_MAX, ARENA_TAG_COMMANDS),
+    };
+    if (!buffer->commands || !buffer->payload || !buffer->created) {
+        TraceLog(LOG_WARNING, "commands_init(): arena exhausted, commands will be dropped");
+        *buffer = (CommandBuffer){ 0 };
+    }
+}
+
+static Command *command_push(CommandBuffer *buffer, const CommandKind kind, const EntityId id) {
+    if (buffer->count >= COMMANDS_MAX || !buffer->commands) {
+        TraceLog(LOG_WARNING, "commands: buffer full (%d), dropping command", COMMANDS_MAX);
+        return NULL;
+    }
+    Command *command = &buffer->commands[buffer->count++];
+    *command = (Command){ .kind = (uint8_t)kind, .entity = id };
+    return command;
+}
+
+EntityId commands_create(CommandBuffer *buffer) {
+    if (!command_push(buffer, COMMAND_CREATE, ENTITY_NONE)) return ENTITY_NONE;
+    return ENTITY_MAKE(buffer->num_created++, ENTITY_GENERATION_PROVISIONAL);
+}
+
+void commands_destroy(CommandBuffer *buffer, const EntityId id) {
+    command_push(buffer, COMMAND_DESTROY, id);
+}
+
+void commands_set(CommandBuffer *buffer, const EntityId id, const ComponentType type, const void *value, const size_t size) {
+    const uint32_t offset = (buffer->payload_used + COMMANDS_PAYLOAD_ALIGN - 1) & ~(uint32_t)(COMMANDS_PAYLOAD_ALIGN - 1);
+    if (offset + size > COMMANDS_PAYLOAD_SIZE) {
+        TraceLog(LOG_WARNING, "commands: payload full (%d bytes), dropping command", COMMANDS_PAYLOAD_SIZE);
+        return;
+    }
+
+    Command *command = command_push(buffer, COMMAND_SET, id);
+    if (!command) return;
+    command->component = (uint8_t)type;
+    command->payload   = offset;
+    memcpy(buffer->payload + offset, value, size);
+    buffer->payload_used = offset + (uint32_t)size;
+}
+
+void commands_remove(CommandBuffer *buffer, const EntityId id, const ComponentType type) {
+    Command *command = command_push(buffer, COMMAND_REMOVE, id);
+    if (command) command->component = (uint8_t)type;
+}
+
+// Provisional handles map to whatever their CREATE produced (ENTITY_NONE if it
+// failed), real handles pass through and the World rejects them if stale.
+static EntityId resolve(const CommandBuffer *buffer, const EntityId id) {
+    if (!ENTITY_IS_PROVISIONAL(id)) return id;
+    const uint32_t index = ENTITY_INDEX(id);
+    return index < buffer->num_created ? buffer->created[index] : ENTITY_NONE;
+}
+
+void commands_playback(CommandBuffer *buffer, World *world) {
+    if (buffer->count == 0) return;
+
+    world_begin_batch(world);
+
+    uint32_t next_created = 0;
+    for (uint32_t i = 0; i < buffer->count; i++) {
+        const Command *command = &buffer->commands[i];
+        switch ((CommandKind)command->kind) {
+            case COMMAND_CREATE:
+                buffer->created[next_created++] = world_create_entity(world);
+                break;
+            case COMMAND_DESTROY:
+                world_destroy_entity(world, resolve(buffer, command->entity));
+                break;
+            case COMMAND_SET:
+                world_set_component(world, resolve(buffer, command->entity), (ComponentType)command->component,
+                                    buffer->payload + command->payload);
+                break;
+            case COMMAND_REMOVE:
+                world_remove_component(world, resolve(buffer, command->entity), (ComponentType)command->component);
+                break;
+        }
+    }
+
+    world_end_batch(world);
+
+    buffer->count        = 0;
+    buffer->payload_used = 0;
+    buffer->num_created  = 0;
+}
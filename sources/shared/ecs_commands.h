@@ -0,0 +1,63 @@
+#ifndef ECS_COMMANDS_H
+#define ECS_COMMANDS_H
+
+#include "shared/arena.h"
+#include "shared/ecs_world.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Deferred structural changes. Systems and collision handlers record creates,
+// destroys and component adds/removes here instead of touching the World while
+// it is being iterated; commands_playback() applies them in recording order at
+// the tick's sync point, inside one world batch, then empties the buffer.
+//
+// commands_create() returns a provisional handle (ENTITY_GENERATION_PROVISIONAL)
+// that later commands in the same buffer may target; playback maps it to the
+// real entity. It is not a valid World handle and is useless after playback.
+//
+// Storage is carved from the arena once by commands_init() and reused every
+// tick. When a tick records more than fits, the overflow is dropped with a
+// warning rather than growing.
+#define COMMANDS_MAX          4096
+#define COMMANDS_PAYLOAD_SIZE (256 * 1024)
+
+typedef enum {
+    COMMAND_CREATE,
+    COMMAND_DESTROY,
+    COMMAND_SET,    // payload holds the component value
+    COMMAND_REMOVE,
+} CommandKind;
+
+typedef struct {
+    uint8_t        kind;      // CommandKind
+    uint8_t        component; // ComponentType, SET/REMOVE only
+    EntityId       entity;    // real or provisional handle
+    uint32_t       payload;   // byte offset into CommandBuffer.payload, SET only
+} Command;
+
+struct CommandBuffer {
+    Command  *commands;
+    uint32_t  count;
+    uint8_t  *payload;
+    uint32_t  payload_used;
+    EntityId *created;     // provisional index -> real handle, filled during playback
+    uint32_t  num_created; // provisional handles handed out this tick
+};
+
+void commands_init(CommandBuffer *buffer, Arena *arena);
+
+EntityId commands_create (CommandBuffer *buffer);
+void     commands_destroy(CommandBuffer *buffer, EntityId id);
+void     commands_set    (CommandBuffer *buffer, EntityId id, ComponentType type, const void *value, size_t size);
+void     commands_remove (CommandBuffer *buffer, EntityId id, ComponentType type);
+
+// Typed add: COMMANDS_SET(buffer, id, COMPONENT_VELOCITY, (Velocity){ .value = v, .remainder = r })
+// Variadic so the commas of a compound literal pass through.
+#define COMMANDS_SET(buffer, id, type, ...) \
+    commands_set((buffer), (id), (type), &(__VA_ARGS__), sizeof(__VA_ARGS__))
+
+// Applies every recorded command to `world`, then resets the buffer.
+void commands_playback(CommandBuffer *buffer, World *world);
+
+#endif //ECS_COMMANDS_H
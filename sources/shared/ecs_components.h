@@ -81,7 +81,14 @@ typedef enum { PILL_VERTICAL, PILL_HORIZONTAL } PillAxis;
 typedef struct { Vector2 offset; Vector2 size; } ShapeRect;
 typedef struct { Vector2 center; float radius; } ShapeCirc;
 typedef struct { Vector2 offset; Vector2 size; PillAxis axis;   } ShapePill;
-typedef struct { Vector2 offset; int cell_size; int cols, rows; uint8_t *solid; } ShapeGrid;
+// Grid cells are bit-packed: row r starts at word r * GRID_ROW_WORDS(cols) of
+// `solid`, cell c in it is bit c % 64 of word c / 64. With `blocks`, a
+// summary level follows the cells: one bit per GRID_BLOCK x GRID_BLOCK block
+// of cells, set when any of them is solid, laid out the same way over the
+// grid of blocks. See collide_grid_*() in game/collision/collision.h.
+#define GRID_BLOCK            8
+#define GRID_ROW_WORDS(cells) (((cells) + 63) / 64)
+typedef struct { Vector2 offset; int cell_size; int cols, rows; bool blocks; uint64_t *solid; } ShapeGrid;
 
 typedef struct {
     ShapeKind kind;
@@ -120,9 +127,9 @@ static Collider collider_pill(const Vector2 offset, const Vector2 size, const Pi
     };
 }
 
-static Collider collider_grid(const int cell_size, const int cols, const int rows, uint8_t *solid, const uint32_t mask, const uint32_t collides_with) {
+static Collider collider_grid(const int cell_size, const int cols, const int rows, uint64_t *solid, const bool blocks, const uint32_t mask, const uint32_t collides_with) {
     return (Collider){
-        .shape = { .kind = SHAPE_GRID, .as.grid = { .cell_size = cell_size, .cols = cols, .rows = rows, .solid = solid }},
+        .shape = { .kind = SHAPE_GRID, .as.grid = { .cell_size = cell_size, .cols = cols, .rows = rows, .blocks = blocks, .solid = solid }},
         .mask = mask, .collides_with = collides_with,
     };
 }
@@ -160,7 +167,7 @@ typedef struct {
 } Animator;
 
 #define TILEMAP_LAYER_OBJECTS   "objects"
-#define TILEMAP_LAYER_COLLISION "solid"
+#define TILEMAP_LAYER_COLLISION "solid"   // tile layer spawn_map() compiles into the map's SHAPE_GRID collider
 
 typedef struct {
     TmxMap   *map;
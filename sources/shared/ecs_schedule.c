@@ -0,0 +1,116 @@
+#include "shared/ecs_schedule.h"
+
+#include <string.h>
+
+_Static_assert(SCHEDULE_MAX_SYSTEMS <= 32, "successor sets are 32-bit masks");
+_Static_assert(SCHEDULE_MAX_CHUNKS  <= 0x10000, "task index packs system << 16 | chunk");
+
+void schedule_init(Schedule *schedule) {
+    memset(schedule, 0, sizeof *schedule);
+}
+
+static bool systems_conflict(const SystemDesc *a, const SystemDesc *b) {
+    if (a->commands && b->commands) return true;
+    return (a->writes & (b->reads | b->writes)) != 0 ||
+           (b->writes & (a->reads | a->writes)) != 0;
+}
+
+void schedule_add(Schedule *schedule, const SystemDesc desc) {
+    if (schedule->num_systems >= SCHEDULE_MAX_SYSTEMS) {
+        TraceLog(LOG_WARNING, "schedule_add(): more than %d systems, dropping %s", SCHEDULE_MAX_SYSTEMS, desc.name);
+        return;
+    }
+
+    // Depend on every earlier system this one conflicts with. Edges implied
+    // by others are kept, they only cost a counter decrement.
+    const uint32_t added = schedule->num_systems++;
+    schedule->systems[added] = desc;
+    for (uint32_t earlier = 0; earlier < added; earlier++) {
+        if (!systems_conflict(&schedule->systems[earlier], &desc)) continue;
+        schedule->successors[earlier] |= 1u << added;
+        schedule->num_deps[added]++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Parallel run
+// ----------------------------------------------------------------------------
+
+static void schedule_release(Schedule *schedule, JobSystem *jobs, uint32_t worker, uint32_t system);
+
+// One range of one system.
+static void schedule_task(JobSystem *jobs, const uint32_t worker, void *ctx, const uint32_t index) {
+    (void)jobs;
+    Schedule         *schedule = ctx;
+    const uint32_t    system   = index >> 16;
+    const uint32_t    chunk    = index & 0xFFFF;
+    const SystemDesc *desc     = &schedule->systems[system];
+
+    uint32_t begin = 0, end = UINT32_MAX;
+    if (schedule->chunks[system] > 1) {
+        const uint64_t rows = schedule->rows[system];
+        begin = (uint32_t)(rows *  chunk      / schedule->chunks[system]);
+        end   = (uint32_t)(rows * (chunk + 1) / schedule->chunks[system]);
+    }
+    desc->fn(schedule->world, &schedule->scratch[worker], schedule->dt, begin, end);
+}
+
+// Continuation of a system's counter, run by whoever finished its last range:
+// releases the successors whose last dependency this was.
+static void schedule_system_done(JobSystem *jobs, const uint32_t worker, void *ctx, const uint32_t system) {
+    Schedule      *schedule   = ctx;
+    const uint32_t successors = schedule->successors[system];
+    for (uint32_t successor = system + 1; successor < schedule->num_systems; successor++) {
+        if (!(successors & (1u << successor))) continue;
+        if (atomic_fetch_sub(&schedule->deps_left[successor], 1) == 1) schedule_release(schedule, jobs, worker, successor);
+    }
+    // Last, so schedule_run() can't return while successors are still being queued.
+    atomic_fetch_sub(&schedule->remaining.pending, 1);
+}
+
+// All dependencies are done: split the system and queue its ranges on the
+// releasing worker's deque. The match count is stable for the whole run,
+// structural changes are deferred.
+static void schedule_release(Schedule *schedule, JobSystem *jobs, const uint32_t worker, const uint32_t system) {
+    const SystemDesc *desc   = &schedule->systems[system];
+    uint32_t          chunks = 1;
+    if (desc->chunk_query) {
+        const uint32_t rows = world_query_count(schedule->world, world_query_cached(schedule->world, desc->chunk_query, 0));
+        const uint32_t most = jobs->num_workers;
+        chunks = rows / SCHEDULE_MIN_CHUNK_ROWS;
+        if (chunks > most)                chunks = most;
+        if (chunks > SCHEDULE_MAX_CHUNKS) chunks = SCHEDULE_MAX_CHUNKS;
+        if (chunks == 0)                  chunks = 1;
+        schedule->rows[system] = rows;
+    }
+    schedule->chunks[system] = chunks;
+
+    jobs_counter_init(&schedule->done[system], schedule_system_done, schedule, system);
+    jobs_run(jobs, worker, schedule_task, schedule, system << 16, chunks, &schedule->done[system]);
+}
+
+void schedule_run(Schedule *schedule, World *world, JobSystem *jobs, Arena *scratch, const float dt) {
+    if (!jobs || jobs->num_workers <= 1 || !schedule->warm) {
+        for (uint32_t system = 0; system < schedule->num_systems; system++) {
+            schedule->systems[system].fn(world, &scratch[0], dt, 0, UINT32_MAX);
+        }
+        schedule->warm = true;
+        return;
+    }
+
+    schedule->world   = world;
+    schedule->scratch = scratch;
+    schedule->dt      = dt;
+    for (uint32_t system = 0; system < schedule->num_systems; system++) {
+        atomic_store(&schedule->deps_left[system], schedule->num_deps[system]);
+    }
+    jobs_counter_init(&schedule->remaining, NULL, NULL, 0);
+    atomic_store(&schedule->remaining.pending, schedule->num_systems);
+
+    // Roots go out in registration order; everything else is released by
+    // whichever of its dependencies finishes last.
+    for (uint32_t system = 0; system < schedule->num_systems; system++) {
+        if (schedule->num_deps[system] == 0) schedule_release(schedule, jobs, 0, system);
+    }
+    jobs_wait(jobs, 0, &schedule->remaining);
+}
@@ -0,0 +1,76 @@
+#ifndef ECS_SCHEDULE_H
+#define ECS_SCHEDULE_H
+
+#include "shared/arena.h"
+#include "shared/ecs_world.h"
+#include "shared/jobs.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Runs a tick's systems on the job system, concurrently where their declared
+// component access allows it, with the same results as calling them one
+// after the other in registration order.
+//
+// Two systems conflict when one writes a component the other reads or writes,
+// or when both record into world->commands (playback order must not depend on
+// timing). A system waits for every earlier system it conflicts with; the rest
+// start as soon as a worker is free. A system whose work is independent per
+// matched entity can also declare the cached query it walks, and is then split
+// into ranges of that query's matches (see world_iter_range()) run in parallel.
+//
+// Systems must touch only what they declare, and must not make structural
+// changes directly: record them into world->commands and declare `commands`.
+// The first run after schedule_init() is serial, so every system registers its
+// cached queries before any of them run concurrently.
+//
+// Holds function pointers into the game module: rebuild it in game_load().
+#define SCHEDULE_MAX_SYSTEMS    32
+#define SCHEDULE_MAX_CHUNKS     64   // ranges one system is split into, at most
+#define SCHEDULE_MIN_CHUNK_ROWS 256  // fewer matches than this per range isn't worth a task
+
+// Runs the system over matches [begin, end) of its chunk query, or over
+// everything when the system isn't split (begin = 0, end = UINT32_MAX).
+// `scratch` belongs to the worker running it, for the duration of the call.
+typedef void (*SystemFn)(World *world, Arena *scratch, float dt, uint32_t begin, uint32_t end);
+
+typedef struct {
+    const char    *name;
+    SystemFn       fn;
+    ComponentMask  reads;       // components read, but not written
+    ComponentMask  writes;      // components written
+    ComponentMask  chunk_query; // required mask of the cached query fn iterates, 0 = never split
+    bool           commands;    // records into world->commands
+} SystemDesc;
+
+typedef struct {
+    SystemDesc     systems[SCHEDULE_MAX_SYSTEMS];
+    uint32_t       num_systems;
+    uint32_t       successors[SCHEDULE_MAX_SYSTEMS]; // bit j: system j waits for this one
+    uint32_t       num_deps  [SCHEDULE_MAX_SYSTEMS]; // earlier systems this one waits for
+    bool           warm;                             // a serial run has registered every query
+
+    // Per-run state, valid during schedule_run()
+    World         *world;
+    Arena         *scratch;                         // one per worker
+    float          dt;
+    uint32_t       rows     [SCHEDULE_MAX_SYSTEMS]; // chunk query matches, split systems only
+    uint32_t       chunks   [SCHEDULE_MAX_SYSTEMS];
+    atomic_uint    deps_left[SCHEDULE_MAX_SYSTEMS];
+    JobCounter     done     [SCHEDULE_MAX_SYSTEMS]; // a system's ranges; releases its successors
+    JobCounter     remaining;                       // systems not finished yet
+} Schedule;
+
+void schedule_init(Schedule *schedule);
+
+// Appends a system. Registration order is the serial order the results match.
+void schedule_add(Schedule *schedule, SystemDesc desc);
+
+// Runs every system once and returns when all of them are done. Call from
+// worker 0; the calling thread runs systems too while it waits. A NULL job
+// system, or one without OS workers, runs them serially on the calling thread.
+// `scratch` has one entry per worker (JOBS_MAX_WORKERS covers any job system).
+void schedule_run(Schedule *schedule, World *world, JobSystem *jobs, Arena *scratch, float dt);
+
+#endif //ECS_SCHEDULE_H
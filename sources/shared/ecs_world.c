@@ -1,71 +1,1010 @@
 #include "shared/ecs_world.h"
 
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+  #include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  #include <arm_neon.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+// Pages are cache-line aligned, which also covers every component's _Alignof.
+#define ECS_PAGE_ALIGN 64
+
+static void *page_alloc(Arena *arena, const size_t bytes) {
+    void *page = arena_alloc(arena, bytes, ECS_PAGE_ALIGN, ARENA_TAG_ECS);
+    if (!page) TraceLog(LOG_WARNING, "ecs: arena exhausted allocating a %zu byte page", bytes);
+    return page;
+}
+
+static int lowest_set_bit(const uint32_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+// Writes `count` copies of a `size`-byte value to `dst`. Copies the value once,
+// then doubles the filled prefix with each memcpy, so N copies cost log2(N) calls.
+static void fill_repeat(uint8_t *dst, const void *value, const size_t size, const uint32_t count) {
+    if (count == 0) return;
+    memcpy(dst, value, size);
+    const size_t total  = size * count;
+    size_t       filled = size;
+    while (filled < total) {
+        const size_t chunk = filled < total - filled ? filled : total - filled;
+        memcpy(dst + filled, dst, chunk);
+        filled += chunk;
+    }
+}
+
+const ComponentInfo COMPONENT_INFO[COMPONENT_COUNT] = {
+#define COMPONENT_INFO_ENTRY(tag, type, name) [COMPONENT_##tag] = { #name, sizeof(type), _Alignof(type) },
+    WORLD_COMPONENTS(COMPONENT_INFO_ENTRY)
+#undef COMPONENT_INFO_ENTRY
+};
+
+// Where each ComponentType's template value lives inside Prefab.
+static const size_t PREFAB_OFFSETS[COMPONENT_COUNT] = {
+#define PREFAB_OFFSET(tag, type, name) [COMPONENT_##tag] = offsetof(Prefab, name),
+    WORLD_COMPONENTS(PREFAB_OFFSET)
+#undef PREFAB_OFFSET
+};
+
+static ComponentStore *world_store(const World *world, const ComponentType type) {
+    return (ComponentStore *)&world->stores[type];
+}
+
+// ----------------------------------------------------------------------------
+// Cached query lists and the signature writes that keep them current.
+// ----------------------------------------------------------------------------
+
+static bool query_matches(const CachedQuery *query, const ComponentMask signature) {
+    return (signature & query->care) == query->want;
+}
+
+// First list position whose slot is >= `slot`.
+static uint32_t cached_lower_bound(const CachedQuery *query, const uint32_t slot) {
+    uint32_t lo = 0;
+    uint32_t hi = query->count;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (ENTITY_INDEX(query->entities[mid]) < slot) lo = mid + 1;
+        else                                           hi = mid;
+    }
+    return lo;
+}
+
+static void cached_insert(World *world, CachedQuery *query, const EntityId id) {
+    if (query->count == query->capacity) {
+        // Doubling; the outgrown list stays behind in the arena, bounded by the final size.
+        const uint32_t capacity = query->capacity ? query->capacity * 2 : ECS_PAGE_SIZE;
+        EntityId      *grown    = page_alloc(world->arena, capacity * sizeof(EntityId));
+        if (!grown) return;
+        if (query->count) memcpy(grown, query->entities, query->count * sizeof(EntityId));
+        query->entities = grown;
+        query->capacity = capacity;
+    }
+    // Spawns and rebuild scans usually land past the highest slot, append without searching.
+    const uint32_t slot = ENTITY_INDEX(id);
+    const bool     tail = query->count == 0 || ENTITY_INDEX(query->entities[query->count - 1]) < slot;
+    const uint32_t at   = tail ? query->count : cached_lower_bound(query, slot);
+    memmove(&query->entities[at + 1], &query->entities[at], (query->count - at) * sizeof(EntityId));
+    query->entities[at] = id;
+    query->count++;
+}
+
+static void cached_remove(CachedQuery *query, const EntityId id) {
+    const uint32_t at = cached_lower_bound(query, ENTITY_INDEX(id));
+    if (at >= query->count || query->entities[at] != id) return;
+    query->count--;
+    memmove(&query->entities[at], &query->entities[at + 1], (query->count - at) * sizeof(EntityId));
+}
+
+// Signature of a live entity, through the handle -> dense slot indirection.
+static ComponentMask *entity_signature(const World *world, const EntityId id) {
+    return &WORLD_SIGNATURE_AT(world, WORLD_SLOT_OF(world, ENTITY_INDEX(id)));
+}
+
+_Static_assert(WORLD_MAX_CACHED_QUERIES <= 32, "dirty_queries has one bit per cached query");
+
+// Every signature write goes through here so registered queries never go stale.
+static void signature_update(World *world, const EntityId id, const ComponentMask after) {
+    ComponentMask      *signature = entity_signature(world, id);
+    const ComponentMask before    = *signature;
+    if (before == after) return;
+    *signature = after;
+
+    // Archetype queries match whole archetypes, there are no per-entity lists to keep.
+    if (world->storage != WORLD_STORAGE_SPARSE) return;
+
+    for (uint32_t q = 0; q < world->num_queries; q++) {
+        CachedQuery *query = &world->queries[q];
+        const bool   was   = query_matches(query, before);
+        const bool   is    = query_matches(query, after);
+        if (was == is) continue;
+        if (world->batching) { world->dirty_queries |= 1u << q; continue; }
+        if (is) cached_insert(world, query, id);
+        else    cached_remove(query, id);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Sparse-set helpers, shared by every component store.
+// ----------------------------------------------------------------------------
+
+// An entity is in the set when its sparse slot points at a live dense entry that points back.
+// Dense entries keep the full handle, so stale generations fail the same compare.
+// Sparse pages are never cleared, the dense back-pointer is what validates them.
+static bool store_contains(const ComponentStore *store, const EntityId id) {
+    const uint32_t  slot        = ENTITY_INDEX(id);
+    if (slot >= MAX_ENTITIES) return false;
+    const uint32_t *sparse_page = store->sparse[slot >> ECS_PAGE_BITS];
+    if (!sparse_page) return false;
+    const uint32_t  index       = sparse_page[slot & ECS_PAGE_MASK];
+    return index < store->count && STORE_ENTITY_AT(*store, index) == id;
+}
+
+static void *store_get(const ComponentStore *store, const EntityId id) {
+    if (!store_contains(store, id)) return NULL;
+    const uint32_t slot  = ENTITY_INDEX(id);
+    const uint32_t index = store->sparse[slot >> ECS_PAGE_BITS][slot & ECS_PAGE_MASK];
+    return store->data[index >> ECS_PAGE_BITS] + (size_t)(index & ECS_PAGE_MASK) * store->size;
+}
+
+// Returns the component slot for `id`, appending it at the end of the packed range if not already present.
+// Allocates whichever sparse/dense/data pages that needs; NULL if the arena ran out.
+// Caller guarantees `id` is alive.
+static void *store_insert(World *world, ComponentStore *store, const EntityId id) {
+    void *existing = store_get(store, id);
+    if (existing) return existing;
+
+    const uint32_t slot        = ENTITY_INDEX(id);
+    const uint32_t sparse_page = slot >> ECS_PAGE_BITS;
+    const uint32_t index       = store->count;
+    const uint32_t dense_page  = index >> ECS_PAGE_BITS;
+    if (dense_page >= ECS_MAX_PAGES) return NULL;
+
+    Arena *arena = world->arena;
+    if (!store->sparse[sparse_page]) store->sparse[sparse_page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(uint32_t));
+    if (!store->dense [dense_page])  store->dense [dense_page]  = page_alloc(arena, ECS_PAGE_SIZE * sizeof(EntityId));
+    if (!store->data  [dense_page])  store->data  [dense_page]  = page_alloc(arena, ECS_PAGE_SIZE * (size_t)store->size);
+    if (!store->sparse[sparse_page] || !store->dense[dense_page] || !store->data[dense_page]) return NULL;
+
+    store->count++;
+    store->sparse[sparse_page][slot & ECS_PAGE_MASK] = index;
+    STORE_ENTITY_AT(*store, index) = id;
+    signature_update(world, id, *entity_signature(world, id) | COMPONENT_BIT(store->type));
+    return store->data[dense_page] + (size_t)(index & ECS_PAGE_MASK) * store->size;
+}
+
+// Swap-remove: the last packed entry moves into the hole so [0, count) stays contiguous.
+static void store_remove(World *world, ComponentStore *store, const EntityId id) {
+    uint8_t *hole = store_get(store, id);
+    if (!hole) return;
+
+    signature_update(world, id, *entity_signature(world, id) & ~COMPONENT_BIT(store->type));
+
+    const uint32_t index = store->sparse[ENTITY_INDEX(id) >> ECS_PAGE_BITS][ENTITY_INDEX(id) & ECS_PAGE_MASK];
+    const uint32_t last  = --store->count;
+    if (index != last) {
+        const EntityId moved      = STORE_ENTITY_AT(*store, last);
+        const uint32_t moved_slot = ENTITY_INDEX(moved);
+        memcpy(hole, store->data[last >> ECS_PAGE_BITS] + (size_t)(last & ECS_PAGE_MASK) * store->size, store->size);
+        STORE_ENTITY_AT(*store, index) = moved;
+        store->sparse[moved_slot >> ECS_PAGE_BITS][moved_slot & ECS_PAGE_MASK] = index;
+    }
+}
+
+// Appends `count` entities that are not in the store yet, all with the same
+// value. Index bookkeeping is per entity, the values go in as one repeated fill
+// per data page. Leaves signatures to the caller. Returns how many were added
+// before the arena ran out.
+static uint32_t store_insert_bulk(World *world, ComponentStore *store, const EntityId *ids, const uint32_t count, const void *value) {
+    Arena         *arena = world->arena;
+    const uint32_t first = store->count;
+
+    uint32_t added = 0;
+    for (; added < count; added++) {
+        const uint32_t slot        = ENTITY_INDEX(ids[added]);
+        const uint32_t sparse_page = slot >> ECS_PAGE_BITS;
+        const uint32_t index       = store->count;
+        const uint32_t dense_page  = index >> ECS_PAGE_BITS;
+        if (dense_page >= ECS_MAX_PAGES) break;
+
+        if (!store->sparse[sparse_page]) store->sparse[sparse_page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(uint32_t));
+        if (!store->dense [dense_page])  store->dense [dense_page]  = page_alloc(arena, ECS_PAGE_SIZE * sizeof(EntityId));
+        if (!store->data  [dense_page])  store->data  [dense_page]  = page_alloc(arena, ECS_PAGE_SIZE * (size_t)store->size);
+        if (!store->sparse[sparse_page] || !store->dense[dense_page] || !store->data[dense_page]) break;
+
+        store->sparse[sparse_page][slot & ECS_PAGE_MASK] = index;
+        STORE_ENTITY_AT(*store, index) = ids[added];
+        store->count++;
+    }
+
+    for (uint32_t index = first; index < first + added; ) {
+        const uint32_t run = ECS_PAGE_SIZE - (index & ECS_PAGE_MASK);
+        const uint32_t n   = run < first + added - index ? run : first + added - index;
+        fill_repeat(store->data[index >> ECS_PAGE_BITS] + (size_t)(index & ECS_PAGE_MASK) * store->size, value, store->size, n);
+        index += n;
+    }
+    return added;
+}
+
+// ----------------------------------------------------------------------------
+// Archetype storage
+// ----------------------------------------------------------------------------
+
+#define ARCHETYPE_COLUMN_ALIGN 16
+
+static EntityLocation *entity_location(const World *world, const uint32_t slot) {
+    return &world->locations[slot >> ECS_PAGE_BITS][slot & ECS_PAGE_MASK];
+}
+
+static bool archetype_matches(const Archetype *arch, const ComponentMask care, const ComponentMask want) {
+    return ((arch->signature | COMPONENT_MASK_ALIVE) & care) == want;
+}
+
+// Cell `row` of the column starting at `column_offset` whose entries are `size` bytes.
+static uint8_t *archetype_cell(const Archetype *arch, const uint32_t column_offset, const uint32_t size, const uint32_t row) {
+    return arch->chunks[row / arch->chunk_rows] + column_offset + (size_t)(row % arch->chunk_rows) * size;
+}
+
+static EntityId *archetype_entity(const Archetype *arch, const uint32_t row) {
+    return (EntityId *)archetype_cell(arch, 0, sizeof(EntityId), row);
+}
+
+static void *archetype_component(const World *world, const Archetype *arch, const ComponentType type, const uint32_t row) {
+    return archetype_cell(arch, arch->column_offset[type], world_store(world, type)->size, row);
+}
+
+// Lays out `rows` rows of every column, returns the chunk bytes that takes.
+static uint32_t archetype_layout(const World *world, Archetype *arch, const uint32_t rows) {
+    uint32_t offset = rows * (uint32_t)sizeof(EntityId);
+    for (ComponentMask bits = arch->signature; bits; bits &= bits - 1) {
+        const ComponentType type = (ComponentType)lowest_set_bit(bits);
+        offset = (offset + ARCHETYPE_COLUMN_ALIGN - 1) & ~(uint32_t)(ARCHETYPE_COLUMN_ALIGN - 1);
+        arch->column_offset[type] = offset;
+        offset += rows * world_store(world, type)->size;
+    }
+    return offset;
+}
+
+static uint32_t archetype_find_or_create(World *world, const ComponentMask signature) {
+    for (uint32_t a = 0; a < world->num_archetypes; a++) {
+        if (world->archetypes[a].signature == signature) return a;
+    }
+    if (world->num_archetypes >= WORLD_MAX_ARCHETYPES) {
+        TraceLog(LOG_WARNING, "ecs: out of archetype slots (%d)", WORLD_MAX_ARCHETYPES);
+        return ARCHETYPE_NONE;
+    }
+
+    Archetype *arch = &world->archetypes[world->num_archetypes];
+    *arch = (Archetype){ .signature = signature };
+
+    // Start from what the raw row size allows, then back off until the column padding fits too.
+    uint32_t row_bytes = sizeof(EntityId);
+    for (ComponentMask bits = signature; bits; bits &= bits - 1) {
+        row_bytes += world_store(world, (ComponentType)lowest_set_bit(bits))->size;
+    }
+    uint32_t rows  = ARCHETYPE_CHUNK_BYTES / row_bytes;
+    if (rows == 0) rows = 1;
+    uint32_t bytes = archetype_layout(world, arch, rows);
+    while (bytes > ARCHETYPE_CHUNK_BYTES && rows > 1) {
+        bytes = archetype_layout(world, arch, --rows);
+    }
+    arch->chunk_rows  = rows;
+    arch->chunk_bytes = bytes > ARCHETYPE_CHUNK_BYTES ? bytes : ARCHETYPE_CHUNK_BYTES;
+    return world->num_archetypes++;
+}
+
+// Appends a row for `id` and points its location at it. The component cells
+// are left for the caller to fill. False if the arena ran out.
+static bool archetype_push(World *world, const uint32_t archetype, const EntityId id) {
+    Archetype     *arch = &world->archetypes[archetype];
+    const uint32_t row  = arch->count;
+
+    if (row / arch->chunk_rows == arch->num_chunks) {
+        if (arch->num_chunks == arch->chunk_capacity) {
+            const uint32_t capacity = arch->chunk_capacity ? arch->chunk_capacity * 2 : 16;
+            uint8_t      **grown    = page_alloc(world->arena, capacity * sizeof(uint8_t *));
+            if (!grown) return false;
+            if (arch->num_chunks) memcpy(grown, arch->chunks, arch->num_chunks * sizeof(uint8_t *));
+            arch->chunks         = grown;
+            arch->chunk_capacity = capacity;
+        }
+        uint8_t *chunk = page_alloc(world->arena, arch->chunk_bytes);
+        if (!chunk) return false;
+        arch->chunks[arch->num_chunks++] = chunk;
+    }
+
+    arch->count++;
+    *archetype_entity(arch, row) = id;
+    *entity_location(world, ENTITY_INDEX(id)) = (EntityLocation){ .archetype = archetype, .row = row };
+    return true;
+}
+
+// Swap-remove, the last row moves into the hole and its entity's location follows.
+static void archetype_remove_row(World *world, const uint32_t archetype, const uint32_t row) {
+    Archetype     *arch = &world->archetypes[archetype];
+    const uint32_t last = --arch->count;
+    if (row == last) return;
+
+    const EntityId moved = *archetype_entity(arch, last);
+    *archetype_entity(arch, row) = moved;
+    for (ComponentMask bits = arch->signature; bits; bits &= bits - 1) {
+        const ComponentType type = (ComponentType)lowest_set_bit(bits);
+        const uint32_t      size = world_store(world, type)->size;
+        memcpy(archetype_cell(arch, arch->column_offset[type], size, row),
+               archetype_cell(arch, arch->column_offset[type], size, last), size);
+    }
+    entity_location(world, ENTITY_INDEX(moved))->row = row;
+}
+
+// Moves `id` into the archetype for `signature`, carrying over the components both share.
+static bool archetype_move(World *world, const EntityId id, const ComponentMask signature) {
+    const EntityLocation from = *entity_location(world, ENTITY_INDEX(id));
+    const uint32_t       to   = archetype_find_or_create(world, signature);
+    if (to == ARCHETYPE_NONE || !archetype_push(world, to, id)) return false;
+
+    const Archetype *src    = &world->archetypes[from.archetype];
+    const Archetype *dst    = &world->archetypes[to];
+    const uint32_t   to_row = dst->count - 1;
+    for (ComponentMask bits = src->signature & dst->signature; bits; bits &= bits - 1) {
+        const ComponentType type = (ComponentType)lowest_set_bit(bits);
+        memcpy(archetype_component(world, dst, type, to_row),
+               archetype_component(world, src, type, from.row), world_store(world, type)->size);
+    }
+    archetype_remove_row(world, from.archetype, from.row);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Component access, dispatched on the world's storage backend
+// ----------------------------------------------------------------------------
+
+static void *component_get(World *world, const ComponentType type, const EntityId id) {
+    if (world->storage == WORLD_STORAGE_SPARSE) return store_get(world_store(world, type), id);
+
+    if (!world_entity_is_alive(world, id)) return NULL;
+    if (!(*entity_signature(world, id) & COMPONENT_BIT(type))) return NULL;
+    const EntityLocation *location = entity_location(world, ENTITY_INDEX(id));
+    return archetype_component(world, &world->archetypes[location->archetype], type, location->row);
+}
+
+// Returns the component slot for `id`, adding the component if missing. NULL if the arena ran out.
+// Caller guarantees `id` is alive.
+static void *component_add(World *world, const ComponentType type, const EntityId id) {
+    if (world->storage == WORLD_STORAGE_SPARSE) return store_insert(world, world_store(world, type), id);
+
+    const ComponentMask signature = *entity_signature(world, id);
+    if (!(signature & COMPONENT_BIT(type))) {
+        const ComponentMask after = signature | COMPONENT_BIT(type);
+        if (!archetype_move(world, id, after & ~COMPONENT_MASK_ALIVE)) return NULL;
+        signature_update(world, id, after);
+    }
+    return component_get(world, type, id);
+}
+
+// Caller guarantees `id` is alive.
+static void component_remove(World *world, const ComponentType type, const EntityId id) {
+    if (world->storage == WORLD_STORAGE_SPARSE) {
+        store_remove(world, world_store(world, type), id);
+        return;
+    }
+
+    const ComponentMask signature = *entity_signature(world, id);
+    if (!(signature & COMPONENT_BIT(type))) return;
+    const ComponentMask after = signature & ~COMPONENT_BIT(type);
+    if (archetype_move(world, id, after & ~COMPONENT_MASK_ALIVE)) signature_update(world, id, after);
+}
+
+#define COMPONENT_SET(world, type, ctype, id, value)                             \
+    do {                                                                         \
+        ctype *slot_ = component_add((world), (type), (id));                     \
+        if (slot_) *slot_ = (value);                                             \
+    } while (0)
+
 // ----------------------------------------------------------------------------
 // Lifecycle
 // ----------------------------------------------------------------------------
 
+void world_init(World *world, Arena *arena, const WorldStorage storage) {
+    memset(world, 0, sizeof *world);
+    world->arena   = arena;
+    world->storage = storage;
+
+    for (ComponentType type = 0; type < COMPONENT_COUNT; type++) {
+        world->stores[type].size = COMPONENT_INFO[type].size;
+        world->stores[type].type = type;
+    }
+}
+
+// Hands out a handle and a dense slot for it, with a zero signature and, under
+// ARCHETYPE storage, no row yet. The caller sets the signature and places the entity.
+static EntityId entity_alloc(World *world) {
+    // Pick both indices and make sure their pages exist before committing
+    // either, so running out of arena never leaves half an entity behind.
+    const bool     reuse_index = world->free_count > 0;
+    const bool     reuse_slot  = world->free_slot_count > 0;
+    const uint32_t index       = reuse_index ? world->free_head      : world->num_handles;
+    const uint32_t slot        = reuse_slot  ? world->free_slot_head : (uint32_t)world->num_entities;
+    if (index >= MAX_ENTITIES || slot >= MAX_ENTITIES) return ENTITY_NONE; // every index an EntityId can address is in use
+
+    Arena *arena = world->arena;
+    if (!reuse_index) {
+        // Fresh index, first one of its page allocates the page.
+        const uint32_t page = index >> ECS_PAGE_BITS;
+        if (!world->entities[page]) world->entities[page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(EntityId));
+        if (!world->slots   [page]) world->slots   [page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(uint32_t));
+        if (!world->entities[page] || !world->slots[page]) return ENTITY_NONE; // arena exhausted
+        if (world->storage == WORLD_STORAGE_ARCHETYPE) {
+            if (!world->locations[page]) world->locations[page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(EntityLocation));
+            if (!world->locations[page]) return ENTITY_NONE;
+        }
+    }
+    if (!reuse_slot) {
+        const uint32_t page = slot >> ECS_PAGE_BITS;
+        if (!world->signatures   [page]) world->signatures   [page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(ComponentMask));
+        if (!world->slot_entities[page]) world->slot_entities[page] = page_alloc(arena, ECS_PAGE_SIZE * sizeof(EntityId));
+        if (!world->signatures[page] || !world->slot_entities[page]) return ENTITY_NONE;
+    }
+
+    uint32_t generation = 0;
+    if (reuse_index) {
+        // Pop the oldest free index. FIFO reuse spreads churn across indices,
+        // so a single index's generation takes longer to wrap around.
+        generation       = ENTITY_GENERATION(WORLD_ENTITY_AT(world, index));
+        world->free_head = ENTITY_INDEX(WORLD_ENTITY_AT(world, index));
+        world->free_count--;
+    } else {
+        world->num_handles++;
+    }
+    if (reuse_slot) {
+        world->free_slot_head = ENTITY_INDEX(WORLD_SLOT_ENTITY_AT(world, slot));
+        world->free_slot_count--;
+    } else {
+        world->num_entities++;
+    }
+
+    const EntityId id = ENTITY_MAKE(index, generation);
+    WORLD_ENTITY_AT     (world, index) = id;
+    WORLD_SLOT_OF       (world, index) = slot;
+    WORLD_SLOT_ENTITY_AT(world, slot)  = id;
+    WORLD_SIGNATURE_AT  (world, slot)  = 0;
+    if (world->storage == WORLD_STORAGE_ARCHETYPE) entity_location(world, index)->archetype = ARCHETYPE_NONE;
+    return id;
+}
+
 EntityId world_create_entity(World *world) {
-    for (int i = 0; i < MAX_ENTITIES; i++) {
-        const EntityId id = (world->next_entity_id + (EntityId)i) % MAX_ENTITIES;
-        if (!world->alive[id]) {
-            world->alive[id] = true;
-            if ((int)id >= world->num_entities) {
-                world->num_entities = (int)id + 1;
-            }
-            world->next_entity_id = (id + 1) % MAX_ENTITIES;
-            return id;
+    const EntityId id = entity_alloc(world);
+    if (id == ENTITY_NONE) return ENTITY_NONE;
+    signature_update(world, id, COMPONENT_MASK_ALIVE);
+
+    if (world->storage == WORLD_STORAGE_ARCHETYPE) {
+        // New entities start out in the empty archetype, which holds nothing but their handle.
+        const uint32_t empty = archetype_find_or_create(world, 0);
+        if (empty == ARCHETYPE_NONE || !archetype_push(world, empty, id)) {
+            world_destroy_entity(world, id);
+            return ENTITY_NONE;
         }
     }
-    // TODO: could we have auto-growing arrays for entities, component stores, etc... stored in the main game arena?
-    return ENTITY_NONE; // pool exhausted
+    return id;
 }
 
 void world_destroy_entity(World *world, const EntityId id) {
-    if (id >= MAX_ENTITIES) return;
-    world->alive[id] = false;
-    world->bounds          .present[id] = false;
-    world->positions       .present[id] = false;
-    world->velocities      .present[id] = false;
-    world->colliders       .present[id] = false;
-    world->renderables     .present[id] = false;
-    world->tex_regions     .present[id] = false;
-    world->animators       .present[id] = false;
-    world->move_platformers.present[id] = false;
-    world->move_topdowns   .present[id] = false;
-    // count not decremented, high-water mark stays
-    // dead slots refill on next `entity_create()`
+    if (!world_entity_is_alive(world, id)) return;
+
+    // Drop out of every cached query in one signature write, the per-store
+    // removals below then find nothing left to update.
+    signature_update(world, id, 0);
+    if (world->storage == WORLD_STORAGE_SPARSE) {
+        for (ComponentType type = 0; type < COMPONENT_COUNT; type++) {
+            store_remove(world, world_store(world, type), id);
+        }
+    } else {
+        const EntityLocation location = *entity_location(world, ENTITY_INDEX(id));
+        if (location.archetype != ARCHETYPE_NONE) archetype_remove_row(world, location.archetype, location.row);
+    }
+
+    // The dense slot goes on the free slot stack; its zero signature already
+    // keeps scans off it until a create reuses it or world_compact() drops it.
+    const uint32_t index = ENTITY_INDEX(id);
+    const uint32_t slot  = WORLD_SLOT_OF(world, index);
+    WORLD_SLOT_ENTITY_AT(world, slot) = ENTITY_MAKE(world->free_slot_head, 0);
+    world->free_slot_head = slot;
+    world->free_slot_count++;
+
+    // Append the index to the free list, bumping the generation it will be
+    // reissued with. The tail's link is the only other entry touched.
+    uint32_t generation = (ENTITY_GENERATION(id) + 1) & ENTITY_GENERATION_MASK;
+    if (generation == ENTITY_GENERATION_PROVISIONAL) generation = 0;
+    WORLD_ENTITY_AT(world, index) = ENTITY_MAKE(ENTITY_INDEX_MASK, generation);
+    if (world->free_count > 0) {
+        const uint32_t tail = world->free_tail;
+        WORLD_ENTITY_AT(world, tail) = ENTITY_MAKE(index, ENTITY_GENERATION(WORLD_ENTITY_AT(world, tail)));
+    } else {
+        world->free_head = index;
+    }
+    world->free_tail = index;
+    world->free_count++;
 }
 
+// A free entry links to a different index, so it can never equal a handle for this index.
 bool world_entity_is_alive(const World *world, const EntityId id) {
-    return id < MAX_ENTITIES && world->alive[id];
+    const uint32_t index = ENTITY_INDEX(id);
+    return index < world->num_handles && WORLD_ENTITY_AT(world, index) == id;
+}
+
+// ----------------------------------------------------------------------------
+// Compaction
+// ----------------------------------------------------------------------------
+
+void world_compact(World *world) {
+    const uint32_t num_slots = (uint32_t)world->num_entities;
+
+    // Stable forward pass: each live slot moves down to the next free position.
+    uint32_t live = 0;
+    for (uint32_t slot = 0; slot < num_slots; slot++) {
+        const ComponentMask signature = WORLD_SIGNATURE_AT(world, slot);
+        if (!(signature & COMPONENT_MASK_ALIVE)) continue;
+
+        if (slot != live) {
+            const EntityId id = WORLD_SLOT_ENTITY_AT(world, slot);
+            WORLD_SIGNATURE_AT  (world, live) = signature;
+            WORLD_SLOT_ENTITY_AT(world, live) = id;
+            WORLD_SLOT_OF(world, ENTITY_INDEX(id)) = live;
+        }
+        live++;
+    }
+
+    world->num_entities    = (int)live;
+    world->free_slot_head  = 0;
+    world->free_slot_count = 0;
+}
+
+bool world_maybe_compact(World *world) {
+    const uint32_t num_slots = (uint32_t)world->num_entities;
+    const uint32_t live      = num_slots - world->free_slot_count;
+    if (num_slots < WORLD_COMPACT_MIN_SLOTS)                          return false;
+    if ((uint64_t)live * 100 >= (uint64_t)num_slots * WORLD_COMPACT_LIVE_PERCENT) return false;
+
+    world_compact(world);
+    return true;
+}
+
+uint32_t world_spawn_batch(World *world, const Prefab *prefab, const uint32_t count, EntityId *out_ids) {
+    const ComponentMask components = prefab->components & ~COMPONENT_MASK_ALIVE;
+
+    uint32_t archetype = ARCHETYPE_NONE;
+    if (world->storage == WORLD_STORAGE_ARCHETYPE) {
+        archetype = archetype_find_or_create(world, components);
+        if (archetype == ARCHETYPE_NONE) return 0;
+    }
+
+    // Handles first. Under ARCHETYPE storage each one goes straight to its final
+    // archetype, so the rows of this batch end up contiguous.
+    uint32_t spawned = 0;
+    for (; spawned < count; spawned++) {
+        const EntityId id = entity_alloc(world);
+        if (id == ENTITY_NONE) break;
+        if (archetype != ARCHETYPE_NONE && !archetype_push(world, archetype, id)) {
+            world_destroy_entity(world, id);
+            break;
+        }
+        out_ids[spawned] = id;
+    }
+    if (spawned == 0) return 0;
+
+    // Then one repeated fill per component, instead of a setter per entity per component.
+    uint32_t added[COMPONENT_COUNT] = { 0 };
+    for (ComponentMask bits = components; bits; bits &= bits - 1) {
+        const ComponentType type  = (ComponentType)lowest_set_bit(bits);
+        const uint8_t      *value = (const uint8_t *)prefab + PREFAB_OFFSETS[type];
+        if (archetype == ARCHETYPE_NONE) {
+            added[type] = store_insert_bulk(world, world_store(world, type), out_ids, spawned, value);
+            continue;
+        }
+
+        const Archetype *arch  = &world->archetypes[archetype];
+        const uint32_t   first = arch->count - spawned;
+        const uint32_t   size  = world_store(world, type)->size;
+        for (uint32_t row = first; row < arch->count; ) {
+            const uint32_t run = arch->chunk_rows - row % arch->chunk_rows;
+            const uint32_t n   = run < arch->count - row ? run : arch->count - row;
+            fill_repeat(archetype_cell(arch, arch->column_offset[type], size, row), value, size, n);
+            row += n;
+        }
+        added[type] = spawned;
+    }
+
+    // Signatures last, with cached query lists rebuilt once for the whole batch.
+    const bool was_batching = world->batching;
+    world_begin_batch(world);
+    for (uint32_t i = 0; i < spawned; i++) {
+        ComponentMask signature = COMPONENT_MASK_ALIVE;
+        for (ComponentMask bits = components; bits; bits &= bits - 1) {
+            const int type = lowest_set_bit(bits);
+            if (i < added[type]) signature |= COMPONENT_BIT(type);
+        }
+        signature_update(world, out_ids[i], signature);
+    }
+    if (!was_batching) world_end_batch(world);
+    return spawned;
 }
 
 // ----------------------------------------------------------------------------
-// Per-component setters
+// Signature queries
 // ----------------------------------------------------------------------------
 
-void world_set_bounds         (World *world, const EntityId id, const Bounds         value) { world->bounds           .present[id] = true; world->bounds           .data[id] = value; }
-void world_set_position       (World *world, const EntityId id, const Position       value) { world->positions        .present[id] = true; world->positions        .data[id] = value; }
-void world_set_velocity       (World *world, const EntityId id, const Velocity       value) { world->velocities       .present[id] = true; world->velocities       .data[id] = value; }
-void world_set_collider       (World *world, const EntityId id, const Collider       value) { world->colliders        .present[id] = true; world->colliders        .data[id] = value; }
-void world_set_renderable     (World *world, const EntityId id, const Renderable     value) { world->renderables      .present[id] = true; world->renderables      .data[id] = value; }
-void world_set_tex_region     (World *world, const EntityId id, const TexRegion      value) { world->tex_regions      .present[id] = true; world->tex_regions      .data[id] = value; }
-void world_set_animator       (World *world, const EntityId id, const Animator       value) { world->animators        .present[id] = true; world->animators        .data[id] = value; }
-void world_set_tilemap        (World *world, const EntityId id, const Tilemap        value) { world->tilemaps         .present[id] = true; world->tilemaps         .data[id] = value; }
-void world_set_move_platformer(World *world, const EntityId id, const MovePlatformer value) { world->move_platformers .present[id] = true; world->move_platformers .data[id] = value; }
-void world_set_move_topdown   (World *world, const EntityId id, const MoveTopdown    value) { world->move_topdowns    .present[id] = true; world->move_topdowns    .data[id] = value; }
+_Static_assert(ECS_PAGE_SIZE % WORLD_QUERY_CHUNK == 0, "query chunks must not straddle pages");
+
+// Match bits for WORLD_QUERY_CHUNK consecutive signatures: bit i set when
+// (sigs[i] & care) == want. One AND + one compare per lane, no branches.
+static uint32_t query_match_chunk(const ComponentMask *sigs, const ComponentMask care, const ComponentMask want) {
+    uint32_t bits = 0;
+#if defined(__AVX2__)
+    const __m256i care_v = _mm256_set1_epi32((int)care);
+    const __m256i want_v = _mm256_set1_epi32((int)want);
+    for (int lane = 0; lane < WORLD_QUERY_CHUNK; lane += 8) {
+        const __m256i sig_v = _mm256_loadu_si256((const __m256i *)(sigs + lane));
+        const __m256i eq_v  = _mm256_cmpeq_epi32(_mm256_and_si256(sig_v, care_v), want_v);
+        bits |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq_v)) << lane;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128i care_v = _mm_set1_epi32((int)care);
+    const __m128i want_v = _mm_set1_epi32((int)want);
+    for (int lane = 0; lane < WORLD_QUERY_CHUNK; lane += 4) {
+        const __m128i sig_v = _mm_loadu_si128((const __m128i *)(sigs + lane));
+        const __m128i eq_v  = _mm_cmpeq_epi32(_mm_and_si128(sig_v, care_v), want_v);
+        bits |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(eq_v)) << lane;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t care_v = vdupq_n_u32(care);
+    const uint32x4_t want_v = vdupq_n_u32(want);
+    const uint32x4_t bit_v  = vld1q_u32(lane_bits);
+    for (int lane = 0; lane < WORLD_QUERY_CHUNK; lane += 4) {
+        const uint32x4_t eq_v = vceqq_u32(vandq_u32(vld1q_u32(sigs + lane), care_v), want_v);
+        bits |= vaddvq_u32(vandq_u32(eq_v, bit_v)) << lane;
+    }
+#else
+    for (int lane = 0; lane < WORLD_QUERY_CHUNK; lane++) {
+        bits |= (uint32_t)((sigs[lane] & care) == want) << lane;
+    }
+#endif
+    return bits;
+}
+
+WorldQuery world_query(const ComponentMask required, const ComponentMask excluded) {
+    // Dead slots have a zero signature, requiring the alive bit filters them for free.
+    return (WorldQuery){
+        .care = required | excluded | COMPONENT_MASK_ALIVE,
+        .want = required | COMPONENT_MASK_ALIVE,
+    };
+}
+
+bool world_query_next(const World *world, WorldQuery *query, EntityId *out_id) {
+    const uint32_t num_slots = (uint32_t)world->num_entities;
+
+    for (;;) {
+        while (query->pending == 0) {
+            if (query->next_slot >= num_slots) return false;
+
+            // Pages hold a whole number of chunks, so a chunk never straddles two pages.
+            // Lanes past the high-water mark read unused page memory and are masked off.
+            const uint32_t       base = query->next_slot;
+            const ComponentMask *sigs = &WORLD_SIGNATURE_AT(world, base);
+            uint32_t bits = query_match_chunk(sigs, query->care, query->want);
+            if (num_slots - base < WORLD_QUERY_CHUNK) {
+                bits &= (1u << (num_slots - base)) - 1;
+            }
+
+            query->pending    = bits;
+            query->chunk_base = base;
+            query->next_slot  = base + WORLD_QUERY_CHUNK;
+        }
+
+        const uint32_t slot = query->chunk_base + (uint32_t)lowest_set_bit(query->pending);
+        query->pending &= query->pending - 1;
+
+        // The chunk's bits may be stale if the caller changed entities further
+        // along in it since the scan, re-check the one slot we're about to yield.
+        if ((WORLD_SIGNATURE_AT(world, slot) & query->care) == query->want) {
+            *out_id = WORLD_SLOT_ENTITY_AT(world, slot);
+            return true;
+        }
+    }
+}
 
 // ----------------------------------------------------------------------------
-// Per-component getters (returns NULL if not present)
+// Cached queries and the join iterator
 // ----------------------------------------------------------------------------
 
-Bounds         *world_get_bounds          (World *world, const EntityId id) { return world->bounds           .present[id] ? &world->bounds           .data[id] : NULL; }
-Position       *world_get_position        (World *world, const EntityId id) { return world->positions        .present[id] ? &world->positions        .data[id] : NULL; }
-Velocity       *world_get_velocity        (World *world, const EntityId id) { return world->velocities       .present[id] ? &world->velocities       .data[id] : NULL; }
-Collider       *world_get_collider        (World *world, const EntityId id) { return world->colliders        .present[id] ? &world->colliders        .data[id] : NULL; }
-Renderable     *world_get_renderable      (World *world, const EntityId id) { return world->renderables      .present[id] ? &world->renderables      .data[id] : NULL; }
-TexRegion      *world_get_tex_region      (World *world, const EntityId id) { return world->tex_regions      .present[id] ? &world->tex_regions      .data[id] : NULL; }
-Animator       *world_get_animator        (World *world, const EntityId id) { return world->animators        .present[id] ? &world->animators        .data[id] : NULL; }
-Tilemap        *world_get_tilemap         (World *world, const EntityId id) { return world->tilemaps         .present[id] ? &world->tilemaps         .data[id] : NULL; }
-MovePlatformer *world_get_move_platformer (World *world, const EntityId id) { return world->move_platformers .present[id] ? &world->move_platformers .data[id] : NULL; }
-MoveTopdown    *world_get_move_topdown    (World *world, const EntityId id) { return world->move_topdowns    .present[id] ? &world->move_topdowns    .data[id] : NULL; }
+QueryId world_query_cached(World *world, const ComponentMask required, const ComponentMask excluded) {
+    const WorldQuery scan = world_query(required, excluded);
+    for (QueryId q = 0; q < world->num_queries; q++) {
+        if (world->queries[q].care == scan.care && world->queries[q].want == scan.want) return q;
+    }
+    if (world->num_queries >= WORLD_MAX_CACHED_QUERIES) {
+        TraceLog(LOG_WARNING, "ecs: out of cached query slots (%d)", WORLD_MAX_CACHED_QUERIES);
+        return QUERY_NONE;
+    }
+
+    const QueryId q     = world->num_queries++;
+    CachedQuery  *query = &world->queries[q];
+    *query = (CachedQuery){ .care = scan.care, .want = scan.want };
+
+    if (world->storage != WORLD_STORAGE_SPARSE) return q;
+
+    // Initial fill, the scan yields ascending slots so appends keep it sorted.
+    WorldQuery fill = scan;
+    EntityId   id;
+    while (world_query_next(world, &fill, &id)) {
+        cached_insert(world, query, id);
+    }
+    return q;
+}
+
+uint32_t world_query_count(const World *world, const QueryId query) {
+    if (query >= world->num_queries) return 0;
+    const CachedQuery *cached = &world->queries[query];
+    if (world->storage == WORLD_STORAGE_SPARSE) return cached->count;
+
+    uint32_t count = 0;
+    for (uint32_t a = 0; a < world->num_archetypes; a++) {
+        const Archetype *arch = &world->archetypes[a];
+        if (archetype_matches(arch, cached->care, cached->want)) count += arch->count;
+    }
+    return count;
+}
+
+WorldIter world_iter(const World *world, const QueryId query) {
+    return world_iter_range(world, query, 0, world_query_count(world, query));
+}
+
+WorldIter world_iter_range(const World *world, const QueryId query, const uint32_t begin, uint32_t end) {
+    WorldIter it = (WorldIter){ .world = world };
+    if (query >= world->num_queries) return it;
+
+    const CachedQuery *cached = &world->queries[query];
+    const uint32_t     count  = world_query_count(world, query);
+    if (end > count) end = count;
+    it.entities = cached->entities;
+    it.cursor   = begin;
+    it.end      = end;
+    it.care     = cached->care;
+    it.want     = cached->want;
+    it.fetch    = cached->want & ~COMPONENT_MASK_ALIVE;
+    for (ComponentMask bits = it.fetch; bits; bits &= bits - 1) {
+        const ComponentType type = (ComponentType)lowest_set_bit(bits);
+        it.sizes[type] = world_store(world, type)->size;
+    }
+
+    if (world->storage == WORLD_STORAGE_ARCHETYPE) {
+        // Skip whole archetypes until the one holding match number `begin`.
+        uint32_t skip = begin;
+        uint32_t a    = 0;
+        for (; a < world->num_archetypes; a++) {
+            const Archetype *arch = &world->archetypes[a];
+            if (!archetype_matches(arch, it.care, it.want)) continue;
+            if (skip < arch->count) break;
+            skip -= arch->count;
+        }
+        it.archetype = a;
+        it.row       = skip;
+    }
+    return it;
+}
+
+// ARCHETYPE storage: rows come straight out of the matching archetypes' chunks,
+// every fetched component is a column of the same chunk. Within a chunk each
+// step is one pointer bump per column; only crossing into the next chunk or
+// archetype resolves addresses again.
+static bool world_iter_next_archetype(WorldIter *it) {
+    if (it->run > 0) {
+        it->run--;
+        it->row++;
+        it->entity = *++it->entity_cell;
+        for (ComponentMask bits = it->fetch; bits; bits &= bits - 1) {
+            const int type = lowest_set_bit(bits);
+            it->components[type] = (uint8_t *)it->components[type] + it->sizes[type];
+        }
+        return true;
+    }
+
+    const World     *world = it->world;
+    const Archetype *arch  = &world->archetypes[it->archetype];
+    if (it->entity_cell) it->row++; // step past the row the last run ended on
+    while (it->row >= arch->count || !archetype_matches(arch, it->care, it->want)) {
+        arch = &world->archetypes[++it->archetype];
+        it->row = 0;
+    }
+
+    const uint32_t row   = it->row;
+    uint8_t       *chunk = arch->chunks[row / arch->chunk_rows];
+    const uint32_t cell  = row % arch->chunk_rows;
+    const uint32_t left  = arch->chunk_rows - cell;
+    const uint32_t rows  = arch->count - row;
+    it->run         = (left < rows ? left : rows) - 1;
+    it->entity_cell = (const EntityId *)chunk + cell;
+    it->entity      = *it->entity_cell;
+    for (ComponentMask bits = it->fetch; bits; bits &= bits - 1) {
+        const int type = lowest_set_bit(bits);
+        it->components[type] = chunk + arch->column_offset[type] + (size_t)cell * it->sizes[type];
+    }
+    return true;
+}
+
+bool world_iter_next(WorldIter *it) {
+    if (it->cursor >= it->end) return false;
+    if (it->world->storage == WORLD_STORAGE_ARCHETYPE) {
+        it->cursor++;
+        return world_iter_next_archetype(it);
+    }
+
+    const EntityId id = it->entities[it->cursor++];
+    it->entity = id;
+
+    // Membership guarantees every fetched component is present, so skip
+    // store_contains() and go straight from sparse to packed data.
+    const uint32_t slot = ENTITY_INDEX(id);
+    for (ComponentMask bits = it->fetch; bits; bits &= bits - 1) {
+        const int             type  = lowest_set_bit(bits);
+        const ComponentStore *store = world_store(it->world, (ComponentType)type);
+        const uint32_t        index = store->sparse[slot >> ECS_PAGE_BITS][slot & ECS_PAGE_MASK];
+        it->components[type] = store->data[index >> ECS_PAGE_BITS] + (size_t)(index & ECS_PAGE_MASK) * it->sizes[type];
+    }
+    return true;
+}
+
+// Length of the longest common prefix of two handle arrays, at most `n`.
+// Whole blocks go through memcmp(), the block that differs is rescanned.
+static uint32_t common_prefix(const EntityId *a, const EntityId *b, const uint32_t n) {
+    uint32_t i = 0;
+    while (i + 16 <= n && memcmp(a + i, b + i, 16 * sizeof(EntityId)) == 0) i += 16;
+    while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+uint32_t world_iter_next_run(WorldIter *it) {
+    if (it->cursor >= it->end) return 0;
+    const uint32_t left = it->end - it->cursor;
+
+    if (it->world->storage == WORLD_STORAGE_ARCHETYPE) {
+        // Resolve the run's first row as usual, then consume the rest of its
+        // chunk in one go: leaving `row` on the run's last row and `run` at
+        // zero makes the next call start at the following row.
+        it->cursor++;
+        world_iter_next_archetype(it);
+        const uint32_t rows = it->run + 1 < left ? it->run + 1 : left;
+        it->cursor += rows - 1;
+        it->row    += rows - 1;
+        it->run    -= rows - 1;
+        return rows;
+    }
+
+    // The first match resolves like world_iter_next(). The run is then as
+    // long as the match list agrees with every store's packed handles from
+    // that point on, a straight compare of two arrays, stopping at page ends
+    // and at the store's live rows: swap-remove leaves stale handles behind
+    // `count` that would otherwise still compare equal.
+    const EntityId *ids  = it->entities + it->cursor;
+    const uint32_t  slot = ENTITY_INDEX(ids[0]);
+    uint32_t        rows = left;
+    for (ComponentMask bits = it->fetch; bits; bits &= bits - 1) {
+        const int             type   = lowest_set_bit(bits);
+        const ComponentStore *store  = world_store(it->world, (ComponentType)type);
+        const uint32_t        index  = store->sparse[slot >> ECS_PAGE_BITS][slot & ECS_PAGE_MASK];
+        const uint32_t        offset = index & ECS_PAGE_MASK;
+        const uint32_t        live   = store->count - index;
+        uint32_t              room   = ECS_PAGE_SIZE - offset;
+        if (room > live) room = live;
+        rows = common_prefix(ids, store->dense[index >> ECS_PAGE_BITS] + offset, rows < room ? rows : room);
+        it->components[type] = store->data[index >> ECS_PAGE_BITS] + (size_t)offset * it->sizes[type];
+    }
+
+    it->entity      = ids[0];
+    it->entity_cell = ids;
+    it->cursor     += rows;
+    return rows;
+}
+
+// ----------------------------------------------------------------------------
+// Batched structural changes
+// ----------------------------------------------------------------------------
+
+void world_begin_batch(World *world) {
+    world->batching = true;
+}
+
+void world_end_batch(World *world) {
+    world->batching = false;
+
+    for (uint32_t dirty = world->dirty_queries; dirty; dirty &= dirty - 1) {
+        CachedQuery *query = &world->queries[lowest_set_bit(dirty)];
+        query->count = 0;
+
+        WorldQuery scan = (WorldQuery){ .care = query->care, .want = query->want };
+        EntityId   id;
+        while (world_query_next(world, &scan, &id)) {
+            cached_insert(world, query, id);
+        }
+    }
+    world->dirty_queries = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Component access by runtime type
+// ----------------------------------------------------------------------------
+
+void world_set_component(World *world, const EntityId id, const ComponentType type, const void *value) {
+    if (!world_entity_is_alive(world, id)) return;
+    void *slot = component_add(world, type, id);
+    if (slot) memcpy(slot, value, world_store(world, type)->size);
+}
+
+void world_remove_component(World *world, const EntityId id, const ComponentType type) {
+    if (world_entity_is_alive(world, id)) component_remove(world, type, id);
+}
+
+// ----------------------------------------------------------------------------
+// Memory report
+// ----------------------------------------------------------------------------
+
+void world_memory_report(const World *world, ComponentMemory out[COMPONENT_COUNT]) {
+    for (ComponentType type = 0; type < COMPONENT_COUNT; type++) {
+        const ComponentStore *store = &world->stores[type];
+        const size_t          size  = COMPONENT_INFO[type].size;
+        ComponentMemory      *mem   = &out[type];
+        *mem = (ComponentMemory){ .count = store->count };
+
+        for (uint32_t page = 0; page < ECS_MAX_PAGES; page++) {
+            if (store->sparse[page]) mem->reserved += ECS_PAGE_SIZE * sizeof(uint32_t);
+            if (store->dense [page]) mem->reserved += ECS_PAGE_SIZE * sizeof(EntityId);
+            if (store->data  [page]) mem->reserved += ECS_PAGE_SIZE * size;
+        }
+        for (uint32_t a = 0; a < world->num_archetypes; a++) {
+            const Archetype *arch = &world->archetypes[a];
+            if (!(arch->signature & COMPONENT_BIT(type))) continue;
+            mem->count    += arch->count;
+            mem->reserved += (size_t)arch->num_chunks * arch->chunk_rows * size;
+        }
+        mem->live = mem->count * size;
+    }
+}
+
+void world_log_memory(const World *world) {
+    ComponentMemory report[COMPONENT_COUNT];
+    world_memory_report(world, report);
+
+    size_t live = 0, reserved = 0;
+    for (ComponentType type = 0; type < COMPONENT_COUNT; type++) {
+        TraceLog(LOG_INFO, "ecs: %-16s %7u live, %9zu / %9zu bytes",
+            COMPONENT_INFO[type].name, report[type].count, report[type].live, report[type].reserved);
+        live     += report[type].live;
+        reserved += report[type].reserved;
+    }
+    TraceLog(LOG_INFO, "ecs: components total %zu / %zu bytes", live, reserved);
+}
+
+// ----------------------------------------------------------------------------
+// Typed accessors, one pair per WORLD_COMPONENTS entry
+// ----------------------------------------------------------------------------
+
+#define COMPONENT_ACCESSORS(tag, type, name)                                \
+    void world_set_##name(World *world, const EntityId id, const type value) { \
+        if (world_entity_is_alive(world, id))                                  \
+            COMPONENT_SET(world, COMPONENT_##tag, type, id, value);            \
+    }                                                                          \
+    type *world_get_##name(World *world, const EntityId id) {                  \
+        return component_get(world, COMPONENT_##tag, id);                      \
+    }
+WORLD_COMPONENTS(COMPONENT_ACCESSORS)
+#undef COMPONENT_ACCESSORS
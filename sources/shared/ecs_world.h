@@ -1,6 +1,7 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include "shared/arena.h"
 #include "shared/assets.h"
 #include "shared/ecs_components.h"
 #include "shared/raytmx.h"
@@ -8,77 +9,359 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#define MAX_ENTITIES 1024
-
+// Entity handles pack a handle index (low bits) and that index's generation (high bits).
+// Destroying an entity bumps its index's generation, so handles held past the
+// destroy stop matching and every lookup rejects them with the same compare.
 typedef uint32_t EntityId;
 #define ENTITY_NONE ((EntityId)-1)
 
-#define DECLARE_COMPONENT_STORE(name, component_type) \
-    typedef struct {                                  \
-        bool           present[MAX_ENTITIES];         \
-        component_type data   [MAX_ENTITIES];         \
-    } name;
-
-DECLARE_COMPONENT_STORE(BoundsStore,         Bounds)
-DECLARE_COMPONENT_STORE(PositionStore,       Position)
-DECLARE_COMPONENT_STORE(VelocityStore,       Velocity)
-DECLARE_COMPONENT_STORE(ColliderStore,       Collider)
-DECLARE_COMPONENT_STORE(RenderableStore,     Renderable)
-DECLARE_COMPONENT_STORE(TexRegionStore,      TexRegion)
-DECLARE_COMPONENT_STORE(AnimatorStore,       Animator)
-DECLARE_COMPONENT_STORE(TilemapStore,        Tilemap)
-DECLARE_COMPONENT_STORE(MovePlatformerStore, MovePlatformer)
-DECLARE_COMPONENT_STORE(MoveTopdownStore,    MoveTopdown)
-
-#undef DECLARE_COMPONENT_STORE
+#define ENTITY_INDEX_BITS      20
+#define ENTITY_INDEX_MASK      ((1u << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GENERATION_MASK ((1u << (32 - ENTITY_INDEX_BITS)) - 1)
+
+#define ENTITY_INDEX(id)       ((uint32_t)(id) & ENTITY_INDEX_MASK)
+#define ENTITY_GENERATION(id)  ((uint32_t)(id) >> ENTITY_INDEX_BITS)
+#define ENTITY_MAKE(index, generation) \
+    ((EntityId)((((uint32_t)(generation) & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | ((uint32_t)(index) & ENTITY_INDEX_MASK)))
+
+// The top generation is never issued to a live entity. Command buffers hand it
+// out as a provisional handle for entities that only exist once played back.
+#define ENTITY_GENERATION_PROVISIONAL ENTITY_GENERATION_MASK
+#define ENTITY_IS_PROVISIONAL(id) \
+    ((id) != ENTITY_NONE && ENTITY_GENERATION(id) == ENTITY_GENERATION_PROVISIONAL)
+
+// Entity slots and component stores grow on demand in fixed-size pages carved
+// from the World's arena. Pages never move once allocated, so a page index plus
+// an offset is all any lookup needs, and stores nobody writes to never allocate.
+#define ECS_PAGE_BITS  10
+#define ECS_PAGE_SIZE  (1u << ECS_PAGE_BITS)
+#define ECS_PAGE_MASK  (ECS_PAGE_SIZE - 1)
+#define ECS_MAX_PAGES  (ENTITY_INDEX_MASK >> ECS_PAGE_BITS)
+#define MAX_ENTITIES   (ECS_MAX_PAGES * ECS_PAGE_SIZE)
+
+_Static_assert(MAX_ENTITIES <= ENTITY_INDEX_MASK, "MAX_ENTITIES must leave ENTITY_INDEX_MASK free as the free-list terminator");
+
+// The component table. Everything per-type in the ECS is generated from this
+// one list: the ComponentType enum, COMPONENT_INFO, the Prefab fields and the
+// typed world_set_* / world_get_* accessors. Stores, destroy and the archetype
+// code are indexed by ComponentType, so adding a component is one line here
+// plus its struct in ecs_components.h.
+//   X(TAG, CType, accessor_name) -> COMPONENT_TAG, world_set_/world_get_accessor_name, Prefab.accessor_name
+#define WORLD_COMPONENTS(X)                             \
+    X(BOUNDS,          Bounds,         bounds)          \
+    X(POSITION,        Position,       position)        \
+    X(VELOCITY,        Velocity,       velocity)        \
+    X(COLLIDER,        Collider,       collider)        \
+    X(RENDERABLE,      Renderable,     renderable)      \
+    X(TEX_REGION,      TexRegion,      tex_region)      \
+    X(ANIMATOR,        Animator,       animator)        \
+    X(TILEMAP,         Tilemap,        tilemap)         \
+    X(MOVE_PLATFORMER, MovePlatformer, move_platformer) \
+    X(MOVE_TOPDOWN,    MoveTopdown,    move_topdown)
+
+// One bit per component type in an entity's signature. COMPONENT_MASK_ALIVE is
+// set for every live slot, so a zero signature means a free (or never used) slot.
+typedef enum {
+#define COMPONENT_ENUM(tag, type, name) COMPONENT_##tag,
+    WORLD_COMPONENTS(COMPONENT_ENUM)
+#undef COMPONENT_ENUM
+    COMPONENT_COUNT,
+} ComponentType;
+
+// Per-type metadata for generic code: memory reports, snapshots, serialization.
+typedef struct {
+    const char *name;  // accessor name, e.g. "move_platformer"
+    uint32_t    size;
+    uint32_t    align;
+} ComponentInfo;
+
+extern const ComponentInfo COMPONENT_INFO[COMPONENT_COUNT];
+
+typedef uint32_t ComponentMask;
+#define COMPONENT_BIT(type)  ((ComponentMask)1u << (type))
+#define COMPONENT_MASK_ALIVE ((ComponentMask)1u << 31)
+
+_Static_assert(COMPONENT_COUNT < 31, "ComponentMask is out of bits");
+
+// Sparse-set component store, paged:
+//   sparse[index]  -> index into dense/data (only meaningful if dense[] points back at the handle)
+//   dense [i]      -> full entity handle owning data[i], generation included
+//   data  [i]      -> packed component values, [0, count) are live
+// sparse is paged by handle index, dense/data by packed index. Swap-remove keeps
+// [0, count) packed, so a component pointer is only stable until its store shrinks.
+typedef struct {
+    uint32_t *sparse[ECS_MAX_PAGES];
+    EntityId *dense [ECS_MAX_PAGES];
+    uint8_t  *data  [ECS_MAX_PAGES];
+    uint32_t       count;
+    uint32_t       size; // COMPONENT_INFO[type].size, set by world_init()
+    ComponentType  type; // signature bit this store maintains, set by world_init()
+} ComponentStore;
+
+// Packed entry `i` of a store, SPARSE storage only. Systems go through queries
+// so they run on either backend; these are for debugging and tooling.
+#define STORE_ENTITY_AT(store, i)     ((store).dense[(i) >> ECS_PAGE_BITS][(i) & ECS_PAGE_MASK])
+#define STORE_DATA_AT(store, type, i) ((type *)(store).data[(i) >> ECS_PAGE_BITS] + ((i) & ECS_PAGE_MASK))
+
+// Where component values live. Both backends share the handle table, the
+// signatures and the query/iterator API, so systems don't care which is active.
+//   SPARSE:    one paged sparse set per component type (above). Cheap
+//              add/remove, a join costs one sparse lookup per component.
+//   ARCHETYPE: entities with the same signature share fixed-size chunks laid
+//              out as SoA columns. A join streams packed columns with no
+//              lookups, adding or removing a component moves the whole entity.
+typedef enum {
+    WORLD_STORAGE_SPARSE = 0,
+    WORLD_STORAGE_ARCHETYPE,
+} WorldStorage;
+
+// Archetype chunk: one EntityId column followed by one column per component in
+// the signature, each 16-byte aligned. `chunk_rows` rows fit in ARCHETYPE_CHUNK_BYTES
+// (a single oversized row gets a chunk of its own size). Rows [0, count) are
+// packed across chunks; removal swaps the last row into the hole.
+#define WORLD_MAX_ARCHETYPES  64
+#define ARCHETYPE_CHUNK_BYTES (16u * 1024u)
+#define ARCHETYPE_NONE        ((uint32_t)-1)
+
+typedef struct {
+    ComponentMask  signature;                      // component bits, COMPONENT_MASK_ALIVE excluded
+    uint32_t       count;                          // live rows
+    uint32_t       chunk_rows;                     // rows per chunk
+    uint32_t       chunk_bytes;
+    uint32_t       column_offset[COMPONENT_COUNT]; // byte offset of each column in a chunk, entity ids sit at 0
+    uint8_t      **chunks;                         // arena-owned, kept when rows shrink
+    uint32_t       num_chunks;
+    uint32_t       chunk_capacity;                 // slots in chunks[], grows by doubling
+} Archetype;
+
+// Row of a live entity in ARCHETYPE storage, paged like the handle table.
+typedef struct {
+    uint32_t archetype;
+    uint32_t row;
+} EntityLocation;
+
+// Registered signature query whose matches the World keeps up to date. Every
+// signature change re-tests the registered queries and inserts or removes the
+// entity here, so a system iterates exactly its matches instead of the slots.
+// Kept sorted by handle index so iteration order is deterministic and walks the stores
+// roughly front to back. The list grows by doubling from the World's arena.
+#define WORLD_MAX_CACHED_QUERIES 32
+
+typedef uint32_t QueryId;
+#define QUERY_NONE ((QueryId)-1)
+
+typedef struct {
+    ComponentMask  care;     // same encoding as WorldQuery
+    ComponentMask  want;
+    EntityId      *entities; // sorted by ENTITY_INDEX, arena-owned
+    uint32_t       count;
+    uint32_t       capacity;
+} CachedQuery;
+
+typedef struct CommandBuffer CommandBuffer;
+typedef struct Broadphase    Broadphase;
 
 typedef struct {
-    bool     alive[MAX_ENTITIES];
-    int      num_entities;
-    EntityId next_entity_id;
+    // Handle table, indexed by ENTITY_INDEX(). Live entries hold their current
+    // handle, free entries hold an intrusive free-list link instead: the next
+    // free index in the index bits and the generation this index will be
+    // reissued with. Paged like the component stores.
+    EntityId      *entities  [ECS_MAX_PAGES];
+    uint32_t      *slots     [ECS_MAX_PAGES]; // handle index -> dense slot, live handles only
+    uint32_t       num_handles;               // high-water mark of handle indices handed out
+    uint32_t       free_head;                 // oldest free index, reused first
+    uint32_t       free_tail;                 // newest free index, destroy appends here
+    uint32_t       free_count;
+
+    // Dense slots, the range signature queries scan. Reached from a handle
+    // through `slots`, so world_compact() can pack the live ones to the front
+    // and lower the high-water mark without invalidating any handle.
+    ComponentMask *signatures   [ECS_MAX_PAGES]; // per-slot component bits, zero for free slots
+    EntityId      *slot_entities[ECS_MAX_PAGES]; // handle living in each slot; free slots link to the next free slot
+    int            num_entities;                 // high-water mark of dense slots
+    uint32_t       free_slot_head;               // free slots, reused last-in first-out
+    uint32_t       free_slot_count;
+
+    Arena         *arena;                     // backing memory for every page, owned by GameMemory
+    WorldStorage   storage;                   // fixed by world_init()
 
     Bounds world_bounds;
     TmxMap *map;
 
-    BoundsStore         bounds;
-    PositionStore       positions;
-    VelocityStore       velocities;
-    ColliderStore       colliders;
-    RenderableStore     renderables;
-    TexRegionStore      tex_regions;
-    AnimatorStore       animators;
-    TilemapStore        tilemaps;
-    MovePlatformerStore move_platformers;
-    MoveTopdownStore    move_topdowns;
+    ComponentStore stores[COMPONENT_COUNT]; // SPARSE storage, indexed by ComponentType
+
+    // ARCHETYPE storage only, the stores above stay empty in that mode.
+    EntityLocation *locations[ECS_MAX_PAGES];
+    Archetype       archetypes[WORLD_MAX_ARCHETYPES];
+    uint32_t        num_archetypes;
+
+    CachedQuery    queries[WORLD_MAX_CACHED_QUERIES];
+    uint32_t       num_queries;
+    bool           batching;      // between world_begin_batch() and world_end_batch()
+    uint32_t       dirty_queries; // bit per cached query whose list is rebuilt at world_end_batch()
+
+    // Where systems record structural changes, played back at the tick's sync
+    // point. Owned by GameMemory, NULL until bound there.
+    CommandBuffer *commands;
+    // Spatial index collision queries consult instead of scanning every
+    // collider. Owned by GameMemory, NULL (full scan) until bound there.
+    Broadphase    *broadphase;
 } World;
 
+#define WORLD_ENTITY_AT(world, index)     ((world)->entities     [(index) >> ECS_PAGE_BITS][(index) & ECS_PAGE_MASK])
+#define WORLD_SLOT_OF(world, index)       ((world)->slots        [(index) >> ECS_PAGE_BITS][(index) & ECS_PAGE_MASK])
+#define WORLD_SIGNATURE_AT(world, slot)   ((world)->signatures   [(slot)  >> ECS_PAGE_BITS][(slot)  & ECS_PAGE_MASK])
+#define WORLD_SLOT_ENTITY_AT(world, slot) ((world)->slot_entities[(slot)  >> ECS_PAGE_BITS][(slot)  & ECS_PAGE_MASK])
+
+// Signature query: yields every live entity whose signature has all `required`
+// bits and none of the `excluded` ones, in ascending dense slot order. The signature
+// array is scanned WORLD_QUERY_CHUNK slots at a time with one masked compare
+// per lane, so runs of non-matching or dead slots cost a few instructions.
+//
+//   WorldQuery query = world_query(COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY), 0);
+//   EntityId   entity_id;
+//   while (world_query_next(world, &query, &entity_id)) { ... }
+//
+// Adding/removing components or destroying entities while iterating is fine:
+// each yielded slot is re-checked, so an entity that stopped matching is skipped.
+// Entities created mid-iteration may or may not be visited.
+#define WORLD_QUERY_CHUNK 16
+
+typedef struct {
+    ComponentMask care;       // required | excluded
+    ComponentMask want;       // required, the value (signature & care) must equal
+    uint32_t      next_slot;  // first slot of the next chunk to scan
+    uint32_t      pending;    // match bits of the current chunk not yet yielded
+    uint32_t      chunk_base; // slot of bit 0 in `pending`
+} WorldQuery;
+
+WorldQuery world_query     (ComponentMask required, ComponentMask excluded);
+bool       world_query_next(const World *world, WorldQuery *query, EntityId *out_id);
+
+// Finds the cached query for this mask pair, registering it on first use with
+// one signature scan. Registrations live in the World, so they survive game
+// module reloads and calling this every tick is just a short linear lookup.
+QueryId    world_query_cached(World *world, ComponentMask required, ComponentMask excluded);
+uint32_t   world_query_count (const World *world, QueryId query);
+
+// Join iterator over a cached query, hands back every required component of
+// each match directly, indexed by ComponentType:
+//
+//   WorldIter it = world_iter(world, world_query_cached(world, COMPONENT_BIT(COMPONENT_POSITION) | COMPONENT_BIT(COMPONENT_VELOCITY), 0));
+//   while (world_iter_next(&it)) {
+//       Position *pos = it.components[COMPONENT_POSITION];
+//       ...
+//   }
+//
+// Structural changes (add/remove/destroy) to matching entities while iterating
+// reorder the list underneath the iterator; defer them until the loop is done.
+// world_iter_range() covers [begin, end) of the match list, for splitting one
+// query's work into chunks. Iterating doesn't touch the World itself, only the
+// component data it points at, so a reader holding a const World can walk a
+// query registered earlier.
+// With ARCHETYPE storage the matches are the rows of every matching archetype,
+// in archetype order, and the component pointers step through packed columns.
+//
+// world_iter_next_run() hands out matches a run at a time instead, for bulk
+// (SIMD) kernels: it returns how many consecutive matches sit at consecutive
+// addresses in every fetched store, `components[type]` points at the first of
+// them (row i at + i * sizes[type]) and `entity_cell` at their handles. Under
+// ARCHETYPE storage a run is the rest of a chunk. Under SPARSE storage a run
+// lasts while the match list lines up with every store's packed order within
+// a page, the common case for entities spawned together; otherwise it is 1.
+// Returns 0 when done. Don't mix it with world_iter_next() on one iterator.
+typedef struct {
+    const World    *world;
+    const EntityId *entities; // SPARSE: the cached match list
+    uint32_t        cursor;
+    uint32_t        end;
+    ComponentMask   care;
+    ComponentMask   want;
+    ComponentMask   fetch;    // components resolved into `components` per match
+    uint32_t        archetype; // ARCHETYPE: current archetype and row within it
+    uint32_t        row;
+    uint32_t        run;       // ARCHETYPE: rows left in the current chunk after this one
+    const EntityId *entity_cell; // ARCHETYPE: current row's handle; runs: first handle of the run
+    EntityId        entity;
+    void           *components[COMPONENT_COUNT];
+    uint32_t        sizes     [COMPONENT_COUNT]; // per fetched component, set by world_iter_range()
+} WorldIter;
+
+WorldIter  world_iter      (const World *world, QueryId query);
+WorldIter  world_iter_range(const World *world, QueryId query, uint32_t begin, uint32_t end);
+bool       world_iter_next (WorldIter *it);
+uint32_t   world_iter_next_run(WorldIter *it);
+
+// Batch window for many structural changes at once. Cached query lists stop
+// being patched per change; the ones that saw any change are rebuilt with a
+// single signature scan at world_end_batch(). Don't iterate them in between.
+void world_begin_batch(World *world);
+void world_end_batch  (World *world);
+
+// Resets the world to empty; all pages are (re)allocated from `arena` on demand.
+// `storage` picks the component backend for the world's lifetime.
+void world_init(World *world, Arena *arena, WorldStorage storage);
+
 // Lifecycle
 EntityId world_create_entity  (World *world);
 void     world_destroy_entity (World *world, EntityId id);
 bool     world_entity_is_alive(const World *world, EntityId id);
 
-// Per-component setters
-void world_set_bounds         (World *world, EntityId id, Bounds         value);
-void world_set_position       (World *world, EntityId id, Position       value);
-void world_set_velocity       (World *world, EntityId id, Velocity       value);
-void world_set_collider       (World *world, EntityId id, Collider       value);
-void world_set_renderable     (World *world, EntityId id, Renderable     value);
-void world_set_tex_region     (World *world, EntityId id, TexRegion      value);
-void world_set_animator       (World *world, EntityId id, Animator       value);
-void world_set_tilemap        (World *world, EntityId id, Tilemap        value);
-void world_set_move_platformer(World *world, EntityId id, MovePlatformer value);
-void world_set_move_topdown   (World *world, EntityId id, MoveTopdown    value);
-
-// Per-component getters (returns NULL if not present)
-Bounds         *world_get_bounds         (World *world, EntityId id);
-Position       *world_get_position       (World *world, EntityId id);
-Velocity       *world_get_velocity       (World *world, EntityId id);
-Collider       *world_get_collider       (World *world, EntityId id);
-Renderable     *world_get_renderable     (World *world, EntityId id);
-TexRegion      *world_get_tex_region     (World *world, EntityId id);
-Animator       *world_get_animator       (World *world, EntityId id);
-Tilemap        *world_get_tilemap        (World *world, EntityId id);
-MovePlatformer *world_get_move_platformer(World *world, EntityId id);
-MoveTopdown    *world_get_move_topdown   (World *world, EntityId id);
+// Destroyed entities leave holes in the dense slot range that signature scans
+// still walk; creates refill them, but after a big wave dies the range stays
+// at its peak. world_compact() moves the live entities into a dense prefix
+// (keeping their order), rewrites their `slots` entries and lowers the
+// high-water mark. Handles, component stores and cached query lists are keyed
+// by handle index and stay as they are. O(high-water mark), run it at a sync
+// point: between levels, or every tick through world_maybe_compact(), which
+// only compacts once the range is at least WORLD_COMPACT_MIN_SLOTS long and
+// under WORLD_COMPACT_LIVE_PERCENT live. Not while a WorldQuery is in flight.
+#define WORLD_COMPACT_MIN_SLOTS    1024
+#define WORLD_COMPACT_LIVE_PERCENT 50
+
+void world_compact      (World *world);
+bool world_maybe_compact(World *world); // true if it compacted
+
+// Pre-resolved component template for world_spawn_batch(). Fill in the values
+// (atlas lookups and the like done once, up front) and mark each one used in
+// `components`; unmarked fields are ignored. Plain data, so a prefab can live
+// in GameMemory and be reused across ticks and reloads.
+typedef struct {
+    ComponentMask  components; // COMPONENT_BIT()s of the values below to apply
+#define PREFAB_FIELD(tag, type, name) type name;
+    WORLD_COMPONENTS(PREFAB_FIELD)
+#undef PREFAB_FIELD
+} Prefab;
+
+// Creates up to `count` entities from `prefab`, writing their handles to
+// `out_ids`. Each component is written with one repeated block copy for the
+// whole batch, and cached query lists are rebuilt once at the end.
+// Returns how many were spawned, fewer than `count` only if memory ran out.
+uint32_t world_spawn_batch(World *world, const Prefab *prefab, uint32_t count, EntityId *out_ids);
+
+// Component access by runtime type, for code that records components as data
+// (command buffers, prefabs). `value` points at one component of that type.
+void world_set_component   (World *world, EntityId id, ComponentType type, const void *value);
+void world_remove_component(World *world, EntityId id, ComponentType type);
+
+// Per-component memory, from world_memory_report(). `reserved` counts every
+// page or chunk share the component holds, live or not.
+typedef struct {
+    uint32_t count;    // live components
+    size_t   live;     // bytes of live component values
+    size_t   reserved; // bytes of pages/chunk columns allocated for it, index arrays included
+} ComponentMemory;
+
+void world_memory_report(const World *world, ComponentMemory out[COMPONENT_COUNT]);
+void world_log_memory   (const World *world);
+
+// Per-component setters (ignored for dead or stale handles) and getters
+// (NULL if not present). A getter's pointer is valid until the next structural
+// change to its store (SPARSE) or archetype (ARCHETYPE).
+#define COMPONENT_ACCESSORS(tag, type, name)                       \
+    void  world_set_##name(World *world, EntityId id, type value); \
+    type *world_get_##name(World *world, EntityId id);
+WORLD_COMPONENTS(COMPONENT_ACCESSORS)
+#undef COMPONENT_ACCESSORS
 
 #endif //WORLD_H
@@ -0,0 +1,215 @@
+#include "shared/hash_map.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  #include <arm_neon.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+_Static_assert(HASH_MAP_GROUP == 16, "group masks are 16-bit, one SIMD register of control bytes");
+
+// ----------------------------------------------------------------------------
+// Hashes
+// ----------------------------------------------------------------------------
+
+// MurmurHash3's 64-bit finalizer: every input bit affects every output bit,
+// so sequential ids spread over both the group index and the 7 tag bits.
+uint64_t hash_u64(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+// FNV-1a, finished with hash_u64() for the high bits FNV leaves weak.
+uint64_t hash_bytes(const void *bytes, const size_t size) {
+    const uint8_t *p    = bytes;
+    uint64_t       hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash_u64(hash);
+}
+
+uint64_t hash_string(const char *str) {
+    return hash_bytes(str, strlen(str));
+}
+
+// ----------------------------------------------------------------------------
+// Control bytes
+// ----------------------------------------------------------------------------
+
+// Bit i set when ctrl[i] == byte, for one group.
+static uint32_t group_match(const uint8_t *ctrl, const uint8_t byte) {
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const uint8_t lane_bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t eq   = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(byte));
+    const uint8x16_t bits = vandq_u8(eq, vld1q_u8(lane_bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) | (uint32_t)vaddv_u8(vget_high_u8(bits)) << 8;
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASH_MAP_GROUP; i++) mask |= (uint32_t)(ctrl[i] == byte) << i;
+    return mask;
+#endif
+}
+
+// Bit i set when ctrl[i] is empty or deleted: the only bytes with the top bit set.
+static uint32_t group_match_free(const uint8_t *ctrl) {
+#if defined(__SSE2__) || defined(_M_X64)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < HASH_MAP_GROUP; i++) mask |= (uint32_t)(ctrl[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+static uint32_t lowest_bit(const uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz(mask);
+#endif
+}
+
+static uint8_t hash_tag  (const uint64_t hash) { return (uint8_t)(hash & 0x7F); }
+static uint32_t hash_group(const uint64_t hash, const uint32_t num_groups) { return (uint32_t)(hash >> 7) & (num_groups - 1); }
+
+// Slot holding `key`, or UINT32_MAX.
+static uint32_t find_slot(const HashMap *map, const uint64_t key, const uint64_t hash) {
+    if (map->capacity == 0) return UINT32_MAX;
+
+    const uint32_t num_groups = map->capacity / HASH_MAP_GROUP;
+    const uint8_t  tag        = hash_tag(hash);
+    uint32_t       group      = hash_group(hash, num_groups);
+    for (uint32_t step = 1; step <= num_groups; step++) {
+        const uint8_t *ctrl = map->ctrl + (size_t)group * HASH_MAP_GROUP;
+        for (uint32_t match = group_match(ctrl, tag); match; match &= match - 1) {
+            const uint32_t slot = group * HASH_MAP_GROUP + lowest_bit(match);
+            if (map->keys[slot] == key) return slot;
+        }
+        if (group_match(ctrl, HASH_MAP_EMPTY)) return UINT32_MAX;
+        group = (group + step) & (num_groups - 1);
+    }
+    return UINT32_MAX;
+}
+
+// First empty or deleted slot on `hash`'s probe sequence. The map must have one.
+static uint32_t find_free_slot(const HashMap *map, const uint64_t hash) {
+    const uint32_t num_groups = map->capacity / HASH_MAP_GROUP;
+    uint32_t       group      = hash_group(hash, num_groups);
+    for (uint32_t step = 1;; step++) {
+        const uint32_t open = group_match_free(map->ctrl + (size_t)group * HASH_MAP_GROUP);
+        if (open) return group * HASH_MAP_GROUP + lowest_bit(open);
+        group = (group + step) & (num_groups - 1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Map
+// ----------------------------------------------------------------------------
+
+// Keep at most 7/8 of the slots full or deleted, so probes stay short and
+// always meet an empty group.
+static uint32_t capacity_for(const uint32_t count) {
+    uint32_t capacity = HASH_MAP_GROUP;
+    while ((uint64_t)capacity * 7 / 8 < count) capacity *= 2;
+    return capacity;
+}
+
+// Moves every key into a fresh block of `capacity` slots.
+static bool rehash(HashMap *map, const uint32_t capacity) {
+    const size_t ctrl_bytes  = capacity;
+    const size_t key_bytes   = sizeof(uint64_t) * capacity;
+    const size_t value_bytes = sizeof(uint32_t) * capacity;
+    uint8_t *block = arena_alloc(map->arena, ctrl_bytes + key_bytes + value_bytes, _Alignof(uint64_t), map->tag);
+    if (!block) return false;
+
+    const HashMap old = *map;
+    map->keys       = (uint64_t *)block;
+    map->values     = (uint32_t *)(block + key_bytes);
+    map->ctrl       = block + key_bytes + value_bytes;
+    map->capacity   = capacity;
+    map->tombstones = 0;
+    memset(map->ctrl, HASH_MAP_EMPTY, ctrl_bytes);
+
+    for (uint32_t slot = 0; slot < old.capacity; slot++) {
+        if (old.ctrl[slot] & 0x80) continue;
+        const uint64_t hash = hash_u64(old.keys[slot]);
+        const uint32_t into = find_free_slot(map, hash);
+        map->ctrl  [into] = hash_tag(hash);
+        map->keys  [into] = old.keys  [slot];
+        map->values[into] = old.values[slot];
+    }
+    return true;
+}
+
+void hash_map_init(HashMap *map, Arena *arena, const uint32_t expected, const ArenaTag tag) {
+    *map = (HashMap){ .arena = arena, .tag = tag };
+    if (expected > 0) rehash(map, capacity_for(expected));
+}
+
+bool hash_map_get(const HashMap *map, const uint64_t key, uint32_t *out_value) {
+    const uint32_t slot = find_slot(map, key, hash_u64(key));
+    if (slot == UINT32_MAX) return false;
+    if (out_value) *out_value = map->values[slot];
+    return true;
+}
+
+bool hash_map_put(HashMap *map, const uint64_t key, const uint32_t value) {
+    const uint64_t hash = hash_u64(key);
+    const uint32_t slot = find_slot(map, key, hash);
+    if (slot != UINT32_MAX) {
+        map->values[slot] = value;
+        return true;
+    }
+
+    if ((uint64_t)(map->count + map->tombstones + 1) * 8 > (uint64_t)map->capacity * 7) {
+        // Sized for the live keys: doubles when they fill it, stays put when tombstones do.
+        if (!rehash(map, capacity_for(map->count + 1))) return false;
+    }
+
+    const uint32_t into = find_free_slot(map, hash);
+    if (map->ctrl[into] == HASH_MAP_DELETED) map->tombstones--;
+    map->ctrl  [into] = hash_tag(hash);
+    map->keys  [into] = key;
+    map->values[into] = value;
+    map->count++;
+    return true;
+}
+
+bool hash_map_remove(HashMap *map, const uint64_t key) {
+    const uint32_t slot = find_slot(map, key, hash_u64(key));
+    if (slot == UINT32_MAX) return false;
+
+    // A group that still has an empty byte ended every probe that reached it,
+    // so nothing further along depends on this slot having been full.
+    const uint8_t *group = map->ctrl + (size_t)(slot / HASH_MAP_GROUP) * HASH_MAP_GROUP;
+    if (group_match(group, HASH_MAP_EMPTY)) {
+        map->ctrl[slot] = HASH_MAP_EMPTY;
+    } else {
+        map->ctrl[slot] = HASH_MAP_DELETED;
+        map->tombstones++;
+    }
+    map->count--;
+    return true;
+}
+
+void hash_map_clear(HashMap *map) {
+    if (map->capacity > 0) memset(map->ctrl, HASH_MAP_EMPTY, map->capacity);
+    map->count      = 0;
+    map->tombstones = 0;
+}
@@ -0,0 +1,55 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include "shared/arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Open-addressing map from 64-bit keys to 32-bit values (usually an index
+// into an array kept next to it), over an Arena.
+//
+// Every slot has a control byte: HASH_MAP_EMPTY, HASH_MAP_DELETED, or the
+// low 7 bits of its key's hash when full. A lookup hashes once, then checks
+// HASH_MAP_GROUP control bytes per step with one SIMD compare against those 7
+// bits and only reads keys whose byte matched; a group with an empty byte
+// ends the probe. Groups are visited in triangular order, which reaches each
+// of them once for power-of-two group counts.
+//
+// Plain data with no function pointers: the hash is fixed, so a map kept in
+// GameMemory keeps working across module reloads. A rehash, on growth or to
+// clear out tombstones left by many removes, moves into a new block and
+// leaves the old one in the arena: pass a realistic `expected` to
+// hash_map_init(), and prefer hash_map_clear() and refilling over long runs
+// of removes. Not thread-safe.
+#define HASH_MAP_GROUP    16
+#define HASH_MAP_EMPTY    0x80
+#define HASH_MAP_DELETED  0xFE
+
+typedef struct {
+    uint8_t  *ctrl;       // `capacity` control bytes
+    uint64_t *keys;
+    uint32_t *values;
+    uint32_t  capacity;   // slots, a power of two, >= HASH_MAP_GROUP; 0 before the first put
+    uint32_t  count;      // full slots
+    uint32_t  tombstones; // deleted slots, reclaimed by the next rehash
+    Arena    *arena;
+    ArenaTag  tag;
+} HashMap;
+
+// Sized so `expected` keys fit without a rehash.
+void hash_map_init  (HashMap *map, Arena *arena, uint32_t expected, ArenaTag tag);
+bool hash_map_get   (const HashMap *map, uint64_t key, uint32_t *out_value);
+// Inserts or overwrites. False when the arena is full, with the map unchanged.
+bool hash_map_put   (HashMap *map, uint64_t key, uint32_t value);
+bool hash_map_remove(HashMap *map, uint64_t key);
+// Empties the map, keeping its capacity.
+void hash_map_clear (HashMap *map);
+
+// The hashes the map and its users key with.
+uint64_t hash_u64   (uint64_t key);
+uint64_t hash_bytes (const void *bytes, size_t size);
+uint64_t hash_string(const char *str);
+
+#endif //HASH_MAP_H
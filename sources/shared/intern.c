@@ -0,0 +1,54 @@
+#include "shared/intern.h"
+
+#include <string.h>
+
+void intern_init(Interner *interner, Arena *arena, const uint32_t expected, const ArenaTag tag) {
+    interner->arena = arena;
+    interner->tag   = tag;
+    hash_map_init(&interner->ids, arena, expected, tag);
+    ARRAY_INIT(&interner->strings, arena, expected, tag);
+}
+
+static bool same_string(const InternString *interned, const char *str, const size_t length) {
+    return interned->length == length && memcmp(interned->chars, str, length) == 0;
+}
+
+// Two strings whose 64-bit hashes collide can't share a map key, so the
+// later one moves on to the next key in a chain derived from the hash.
+// Walks the chain for `str` until it finds it (returns its id) or a free key
+// (returns INTERN_NONE with *out_key set to it).
+static InternId lookup(const Interner *interner, const char *str, const size_t length, uint64_t *out_key) {
+    uint64_t key = hash_bytes(str, length);
+    uint32_t id;
+    while (hash_map_get(&interner->ids, key, &id)) {
+        if (same_string(&interner->strings.items[id - 1], str, length)) return id;
+        key = hash_u64(key + 1);
+    }
+    if (out_key) *out_key = key;
+    return INTERN_NONE;
+}
+
+InternId intern_add(Interner *interner, const char *str) {
+    const size_t   length = strlen(str);
+    uint64_t       key;
+    const InternId found  = lookup(interner, str, length, &key);
+    if (found != INTERN_NONE) return found;
+
+    char *chars = arena_alloc(interner->arena, length + 1, 1, interner->tag);
+    if (!chars || !ARRAY_RESERVE(&interner->strings, interner->strings.count + 1)) return INTERN_NONE;
+    memcpy(chars, str, length + 1);
+
+    const InternId id = interner->strings.count + 1;
+    if (!hash_map_put(&interner->ids, key, id)) return INTERN_NONE;
+    (void)ARRAY_PUSH(&interner->strings, ((InternString){ chars, (uint32_t)length })); // reserved above
+    return id;
+}
+
+InternId intern_find(const Interner *interner, const char *str) {
+    return lookup(interner, str, strlen(str), NULL);
+}
+
+const char *intern_string(const Interner *interner, const InternId id) {
+    if (id == INTERN_NONE || id > interner->strings.count) return NULL;
+    return interner->strings.items[id - 1].chars;
+}
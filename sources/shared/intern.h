@@ -0,0 +1,45 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "shared/arena.h"
+#include "shared/array.h"
+#include "shared/hash_map.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// String interner: each distinct string gets a small id, so names can be
+// stored, compared and hashed as integers after one lookup.
+//
+// Strings are copied into the arena on first sight, never referenced where
+// they came from: a literal in the game module's .rodata would dangle after
+// a reload, the interned copy doesn't. Ids are dense, starting at 1, and
+// stay valid until the arena is reset. Not thread-safe.
+typedef uint32_t InternId;
+
+#define INTERN_NONE 0
+
+typedef struct {
+    const char *chars;  // NUL-terminated copy in the arena
+    uint32_t    length;
+} InternString;
+
+typedef struct {
+    HashMap             ids;     // string hash -> id; a colliding string rehashes its key, see intern.c
+    ARRAY(InternString) strings; // [id - 1]
+    Arena              *arena;
+    ArenaTag            tag;
+} Interner;
+
+void intern_init(Interner *interner, Arena *arena, uint32_t expected, ArenaTag tag);
+
+// The id of `str`, added if new. INTERN_NONE when the arena is full.
+InternId intern_add(Interner *interner, const char *str);
+
+// The id of `str` if it was added before, else INTERN_NONE.
+InternId intern_find(const Interner *interner, const char *str);
+
+// The interned copy, or NULL for INTERN_NONE and unknown ids.
+const char *intern_string(const Interner *interner, InternId id);
+
+#endif //INTERN_H
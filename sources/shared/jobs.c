@@ -0,0 +1,216 @@
+#include "shared/jobs.h"
+#include "raylib.h"
+
+#include <string.h>
+
+#define JOBS_DEQUE_MASK (JOBS_DEQUE_SIZE - 1)
+
+// ----------------------------------------------------------------------------
+// Deque (Chase & Lev 2005, with the C11 orderings from Lê et al. 2013)
+// ----------------------------------------------------------------------------
+
+// Owner only. False when the ring is full.
+static bool deque_push(JobDeque *deque, const Job *job) {
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    const int64_t top    = atomic_load_explicit(&deque->top,    memory_order_acquire);
+    if (bottom - top >= JOBS_DEQUE_SIZE) return false;
+
+    deque->jobs[bottom & JOBS_DEQUE_MASK] = *job;
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release); // publishes the job to thieves
+    return true;
+}
+
+// Owner only, takes the newest job. Races thieves only for the last one.
+static bool deque_pop(JobDeque *deque, Job *out) {
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) { // empty
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    *out = deque->jobs[bottom & JOBS_DEQUE_MASK];
+    if (top < bottom) return true;
+
+    // Last job: whoever moves `top` first gets it.
+    const bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                             memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return won;
+}
+
+// Any thread, takes the oldest job. False when empty or another thief won.
+static bool deque_steal(JobDeque *deque, Job *out) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) return false;
+
+    *out = deque->jobs[top & JOBS_DEQUE_MASK];
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Workers
+// ----------------------------------------------------------------------------
+
+// Own deque first, then the others' in turn starting with the next worker up.
+static bool find_job(JobSystem *jobs, const uint32_t worker, Job *out) {
+    if (deque_pop(&jobs->deques[worker], out)) return true;
+    for (uint32_t i = 1; i < jobs->num_workers; i++) {
+        const uint32_t victim = (worker + i) % jobs->num_workers;
+        if (deque_steal(&jobs->deques[victim], out)) return true;
+    }
+    return false;
+}
+
+static void execute(JobSystem *jobs, const uint32_t worker, const Job *job) {
+    job->fn(jobs, worker, job->ctx, job->index);
+
+    JobCounter *counter = job->counter;
+    if (!counter) return;
+    // Read the continuation first: once `pending` hits zero a waiter may
+    // return and take the counter's storage with it.
+    const JobFn    then       = counter->then;
+    void          *then_ctx   = counter->then_ctx;
+    const uint32_t then_index = counter->then_index;
+    if (atomic_fetch_sub(&counter->pending, 1) == 1 && then) then(jobs, worker, then_ctx, then_index);
+}
+
+static void wake_workers(JobSystem *jobs, const uint32_t count) {
+    atomic_fetch_add(&jobs->epoch, 1);
+    if (atomic_load(&jobs->sleepers) == 0) return;
+
+    mutex_lock(&jobs->lock);
+    if (count > 1) cond_broadcast(&jobs->wake);
+    else           cond_signal   (&jobs->wake);
+    mutex_unlock(&jobs->lock);
+}
+
+static void worker_main(void *arg) {
+    JobSystem     *jobs   = arg;
+    const uint32_t worker = atomic_fetch_add(&jobs->started, 1) + 1;
+
+    while (!atomic_load(&jobs->quit)) {
+        const unsigned epoch = atomic_load(&jobs->epoch);
+        Job            job;
+        if (find_job(jobs, worker, &job)) {
+            execute(jobs, worker, &job);
+            continue;
+        }
+
+        // Nothing anywhere. Sleep unless something was pushed since `epoch`
+        // was read: pushers bump it before checking `sleepers`, and we count
+        // ourselves in before re-checking it, so one of us sees the other.
+        mutex_lock(&jobs->lock);
+        atomic_fetch_add(&jobs->sleepers, 1);
+        while (atomic_load(&jobs->epoch) == epoch && !atomic_load(&jobs->quit)) {
+            cond_wait(&jobs->wake, &jobs->lock);
+        }
+        atomic_fetch_sub(&jobs->sleepers, 1);
+        mutex_unlock(&jobs->lock);
+    }
+}
+
+void jobs_start(JobSystem *jobs, uint32_t num_threads) {
+    memset(jobs, 0, sizeof *jobs);
+    mutex_init(&jobs->lock);
+    cond_init(&jobs->wake);
+
+    if (num_threads > JOBS_MAX_WORKERS - 1) num_threads = JOBS_MAX_WORKERS - 1;
+    jobs->num_workers = 1 + num_threads; // set before any worker starts looking at deques
+    for (uint32_t i = 1; i <= num_threads; i++) {
+        if (!thread_start(&jobs->threads[i], worker_main, jobs)) {
+            // The missing workers' deques just stay empty.
+            TraceLog(LOG_WARNING, "jobs_start(): started %u of %u worker threads", i - 1, num_threads);
+            break;
+        }
+        jobs->num_threads++;
+    }
+}
+
+void jobs_stop(JobSystem *jobs) {
+    mutex_lock(&jobs->lock);
+    atomic_store(&jobs->quit, true);
+    cond_broadcast(&jobs->wake);
+    mutex_unlock(&jobs->lock);
+
+    for (uint32_t i = 1; i <= jobs->num_threads; i++) thread_join(&jobs->threads[i]);
+    jobs->num_threads = 0;
+
+    cond_destroy(&jobs->wake);
+    mutex_destroy(&jobs->lock);
+    jobs->num_workers = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Submitting and waiting
+// ----------------------------------------------------------------------------
+
+void jobs_counter_init(JobCounter *counter, const JobFn then, void *then_ctx, const uint32_t then_index) {
+    atomic_init(&counter->pending, 0);
+    counter->then       = then;
+    counter->then_ctx   = then_ctx;
+    counter->then_index = then_index;
+}
+
+void jobs_run(JobSystem *jobs, const uint32_t worker, const JobFn fn, void *ctx,
+              const uint32_t first_index, const uint32_t count, JobCounter *counter) {
+    if (count == 0) return;
+    if (counter) atomic_fetch_add(&counter->pending, count);
+
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const Job job = (Job){ fn, ctx, first_index + i, counter };
+        if (deque_push(&jobs->deques[worker], &job)) queued++;
+        else                                          execute(jobs, worker, &job);
+    }
+    if (queued > 0 && jobs->num_workers > 1) wake_workers(jobs, queued);
+}
+
+void jobs_wait(JobSystem *jobs, const uint32_t worker, JobCounter *counter) {
+    while (atomic_load(&counter->pending) > 0) {
+        Job job;
+        if (find_job(jobs, worker, &job)) execute(jobs, worker, &job);
+        else                              thread_yield(); // the rest is running elsewhere
+    }
+}
+
+typedef struct {
+    RangeFn   fn;
+    void     *ctx;
+    uint32_t  count;
+    uint32_t  ranges;
+} ParallelFor;
+
+static void parallel_for_range(JobSystem *jobs, const uint32_t worker, void *ctx, const uint32_t index) {
+    (void)jobs;
+    const ParallelFor *pf    = ctx;
+    const uint32_t     begin = (uint32_t)((uint64_t)pf->count *  index      / pf->ranges);
+    const uint32_t     end   = (uint32_t)((uint64_t)pf->count * (index + 1) / pf->ranges);
+    pf->fn(pf->ctx, begin, end, worker);
+}
+
+void jobs_parallel_for(JobSystem *jobs, const uint32_t worker, const uint32_t count, uint32_t min_range,
+                       const RangeFn fn, void *ctx) {
+    if (count == 0) return;
+    if (min_range == 0) min_range = 1;
+
+    // A few ranges per worker, so whoever finishes early has something to steal.
+    uint32_t       ranges = count / min_range;
+    const uint32_t most   = jobs->num_workers * 4;
+    if (ranges > most) ranges = most;
+    if (ranges <= 1) {
+        fn(ctx, 0, count, worker);
+        return;
+    }
+
+    ParallelFor pf = (ParallelFor){ fn, ctx, count, ranges };
+    JobCounter  counter;
+    jobs_counter_init(&counter, NULL, NULL, 0);
+    jobs_run (jobs, worker, parallel_for_range, &pf, 0, ranges, &counter);
+    jobs_wait(jobs, worker, &counter);
+}
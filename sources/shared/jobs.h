@@ -0,0 +1,100 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "shared/threads.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Work-stealing job system. Every worker owns a deque: it pushes and pops
+// its own jobs at the bottom (LIFO, cache-warm), idle workers steal from the
+// top of someone else's (FIFO, the oldest and usually biggest pieces).
+//
+// Worker 0 is the thread that calls jobs_start(), normally the main thread;
+// it has a deque but no OS thread of its own and only runs jobs while it
+// waits in jobs_wait(). Workers 1..num_workers-1 are OS threads.
+//
+// Worker identity is passed around explicitly (every JobFn gets the index of
+// the worker running it) rather than kept in thread-locals: shared/ is
+// compiled into both the platform and the game module, and each would see
+// its own copy of a thread-local.
+//
+// Ownership across hot reloads: the platform calls jobs_start() and
+// jobs_stop(), so the threads run the platform's copy of this code and
+// survive game module reloads. The game module only submits and waits; every
+// job it submitted must be done before game_unload() returns, since the job
+// functions live in the module.
+#define JOBS_MAX_WORKERS 16   // including worker 0
+#define JOBS_DEQUE_SIZE  4096 // per worker, power of two
+
+typedef struct JobSystem JobSystem;
+
+// `worker` is the index of the worker running the job, for submitting
+// follow-up jobs or picking per-worker resources.
+typedef void (*JobFn)(JobSystem *jobs, uint32_t worker, void *ctx, uint32_t index);
+
+// Counts unfinished jobs. jobs_wait() waits for zero. The optional `then`
+// runs right after the job that brings `pending` to zero, on that job's
+// worker, which is how one batch of jobs starts the next: see ecs_schedule.c.
+typedef struct {
+    atomic_uint pending;
+    JobFn       then;
+    void       *then_ctx;
+    uint32_t    then_index;
+} JobCounter;
+
+typedef struct {
+    JobFn       fn;
+    void       *ctx;
+    uint32_t    index;
+    JobCounter *counter; // may be NULL
+} Job;
+
+// Chase-Lev deque over a fixed ring. Only the owner moves `bottom`; thieves
+// race each other, and the owner for the last job, on `top` with a CAS.
+typedef struct {
+    _Alignas(64) _Atomic int64_t top;
+    _Alignas(64) _Atomic int64_t bottom;
+    Job                          jobs[JOBS_DEQUE_SIZE];
+} JobDeque;
+
+struct JobSystem {
+    JobDeque     deques [JOBS_MAX_WORKERS];
+    Thread       threads[JOBS_MAX_WORKERS]; // [1, num_threads], worker 0 is the caller's thread
+    uint32_t     num_threads;               // OS threads actually started
+    uint32_t     num_workers;               // including worker 0
+
+    // Idle workers sleep on `wake`. Pushers bump `epoch` and only take the
+    // lock when someone is asleep, so the hot path stays lock-free.
+    ThreadMutex  lock;
+    ThreadCond   wake;
+    atomic_uint  epoch;
+    atomic_uint  sleepers;
+    atomic_uint  started;  // OS workers that claimed an index
+    atomic_bool  quit;
+};
+
+// Starts `num_threads` OS workers (capped at JOBS_MAX_WORKERS - 1) next to the
+// calling thread, which becomes worker 0. Zero threads is valid: everything
+// then runs on worker 0 inside jobs_wait().
+void jobs_start(JobSystem *jobs, uint32_t num_threads);
+void jobs_stop (JobSystem *jobs);
+
+void jobs_counter_init(JobCounter *counter, JobFn then, void *then_ctx, uint32_t then_index);
+
+// Queues fn(ctx, first_index + i) for i in [0, count) on `worker`'s deque,
+// adding `count` to `counter` before any of them can finish. Call from the
+// thread that is `worker`. A full deque runs the overflow right away.
+void jobs_run(JobSystem *jobs, uint32_t worker, JobFn fn, void *ctx, uint32_t first_index, uint32_t count, JobCounter *counter);
+
+// Runs and steals jobs on the calling worker until `counter` reaches zero.
+void jobs_wait(JobSystem *jobs, uint32_t worker, JobCounter *counter);
+
+// Splits [0, count) into ranges of at least `min_range` indices, runs
+// fn(ctx, begin, end, worker) for each across the workers and returns when all
+// are done. Callable from inside jobs too.
+typedef void (*RangeFn)(void *ctx, uint32_t begin, uint32_t end, uint32_t worker);
+void jobs_parallel_for(JobSystem *jobs, uint32_t worker, uint32_t count, uint32_t min_range, RangeFn fn, void *ctx);
+
+#endif //JOBS_H
@@ -0,0 +1,74 @@
+#include "shared/pool.h"
+#include "raylib.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+void pool_init(Pool *pool, Arena *arena, size_t item_size, size_t item_align, const ArenaTag tag) {
+    // Every item, free or not, must be able to hold the free-list link.
+    if (item_align < _Alignof(void *)) item_align = _Alignof(void *);
+    if (item_size  < sizeof(void *))   item_size  = sizeof(void *);
+    item_size = (item_size + item_align - 1) & ~(item_align - 1);
+
+    *pool = (Pool){
+        .arena      = arena,
+        .tag        = tag,
+        .item_size  = item_size,
+        .item_align = item_align,
+    };
+}
+
+#if POOL_DEBUG
+static void pool_check_poison(const Pool *pool, const uint8_t *item) {
+    for (size_t i = sizeof(void *); i < pool->item_size; i++) {
+        if (item[i] != POOL_POISON) {
+            TraceLog(LOG_WARNING, "pool_alloc(): item %p was written after it was freed (byte %zu)", (const void *)item, i);
+            return;
+        }
+    }
+}
+#endif
+
+void *pool_alloc(Pool *pool) {
+    uint8_t *item = pool->free_list;
+    if (item) {
+        memcpy(&pool->free_list, item, sizeof(void *));
+#if POOL_DEBUG
+        pool_check_poison(pool, item);
+#endif
+    } else {
+        // Carve a new block only when the last one is used up; its items are
+        // handed out in order and never walked to build a list.
+        if (pool->bump == pool->bump_end) {
+            const size_t bytes = pool->item_size * POOL_ITEMS_PER_BLOCK;
+            pool->bump = arena_alloc(pool->arena, bytes, pool->item_align, pool->tag);
+            if (!pool->bump) {
+                pool->bump_end = NULL;
+                return NULL;
+            }
+            pool->bump_end = pool->bump + bytes;
+        }
+        item        = pool->bump;
+        pool->bump += pool->item_size;
+    }
+#if POOL_DEBUG
+    memset(item, POOL_FRESH, pool->item_size);
+#endif
+    pool->live++;
+    return item;
+}
+
+void pool_free(Pool *pool, void *item) {
+    if (!item) return;
+#if POOL_DEBUG
+    // Still fully poisoned: most likely already on the free list.
+    const uint8_t *bytes    = item;
+    bool           poisoned = pool->item_size > sizeof(void *);
+    for (size_t i = sizeof(void *); poisoned && i < pool->item_size; i++) poisoned = bytes[i] == POOL_POISON;
+    if (poisoned) TraceLog(LOG_WARNING, "pool_free(): item %p looks freed already", item);
+    memset(item, POOL_POISON, pool->item_size);
+#endif
+    memcpy(item, &pool->free_list, sizeof(void *));
+    pool->free_list = item;
+    pool->live--;
+}
@@ -0,0 +1,52 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "shared/arena.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-size object pool over an Arena: O(1) alloc and free through an
+// intrusive free list, for objects that churn (per-entity side data,
+// collision event records) and would otherwise leak arena space for good.
+//
+// Memory comes from the arena POOL_ITEMS_PER_BLOCK items at a time and is
+// never handed back to it; freed items are reused by the next alloc, newest
+// first. Not thread-safe.
+//
+// With POOL_DEBUG (on unless NDEBUG), freed items are filled with
+// POOL_POISON past the free-list link, and an alloc that finds the pattern
+// disturbed reports a write after free. Fresh items are filled with
+// POOL_FRESH so code relying on zeroes shows up.
+#ifndef POOL_DEBUG
+  #ifdef NDEBUG
+    #define POOL_DEBUG 0
+  #else
+    #define POOL_DEBUG 1
+  #endif
+#endif
+
+#define POOL_ITEMS_PER_BLOCK 256
+#define POOL_POISON          0xDD
+#define POOL_FRESH           0xCD
+
+typedef struct {
+    Arena    *arena;
+    ArenaTag  tag;
+    size_t    item_size;  // >= sizeof(void *), a multiple of item_align
+    size_t    item_align;
+    void     *free_list;  // freed items, each starting with the next one's address
+    uint8_t  *bump;       // untouched items left in the newest block
+    uint8_t  *bump_end;
+    uint32_t  live;       // allocated and not freed
+} Pool;
+
+void  pool_init (Pool *pool, Arena *arena, size_t item_size, size_t item_align, ArenaTag tag);
+void *pool_alloc(Pool *pool); // NULL when the arena is full
+void  pool_free (Pool *pool, void *item);
+
+// Typed wrappers: POOL_INIT(&pool, arena, CollisionEvent, ARENA_TAG_ECS); CollisionEvent *e = POOL_NEW(&pool, CollisionEvent);
+#define POOL_INIT(pool, arena, type, tag) pool_init((pool), (arena), sizeof(type), _Alignof(type), (tag))
+#define POOL_NEW(pool, type)              ((type*)pool_alloc(pool))
+
+#endif //POOL_H
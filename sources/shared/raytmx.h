@@ -34,7 +34,7 @@
 
 #include <ctype.h> // Required for: isspace().
 #include <math.h> // Required for: fabs(), floor(), INFINITY, roundf().
-#include <stddef.h> // Required for: NULL.
+#include <stddef.h> // Required for: NULL, size_t.
 #include <stdint.h> // Required for: int32_t, uint32_t.
 #include <stdlib.h> // Required for: atoi(), strtoul().
 #include <string.h> // Required for: memcpy(), memset(), strcpy(), strcpy_s() strlen(), strncpy(), strncpy_s().
@@ -57,6 +57,14 @@
 // Function signature of raylib's LoadTexture() as a type. For use with SetLoadTextureTMX().
 typedef Texture2D (*LoadTextureCallback)(const char *fileName);
 
+// Caller-provided memory for LoadTMXInto(). 'alloc' returns 'size' bytes aligned for any type, contents unspecified,
+// with 'user' passed back untouched. Nothing is ever handed back to it; the caller discards the memory as a whole.
+typedef void *(*TmxAllocCallback)(void *user, size_t size);
+typedef struct TmxAllocator {
+    TmxAllocCallback alloc;
+    void *user;
+} TmxAllocator;
+
 // Bit flags passed to SetTraceLogFlagsTMX() that optionally disable the logging of specific TMX elements.
 enum TmxLogFlags {
     LOG_SKIP_PROPERTIES = 1,     // Skip <properties> and child <property> elements.
@@ -379,11 +387,21 @@ typedef struct TmxMap {
     TmxTile *gidsToTiles;       // Array of pre-calculated tile metadata with values needed to quickly draw a tile given
                                 // its GID. Allocated such that e.g. gidsToTiles[11] gets the data of tile GID eleven.
     uint32_t gidsToTilesLength; // Length of the 'gidsToTiles' array.
+    bool isPacked;              // When true, the map and everything it points to is one block owned by the caller of
+                                // LoadTMXInto(). UnloadTMX() then only unloads textures.
 } TmxMap;
 
 // Load a TMX map from disk. To clean up, use UnloadTMX().
  RAYTMX_DEC TmxMap *LoadTMX(const char *fileName);
 
+// Load a TMX map without touching the heap. Everything needed only while parsing (the XML buffer, linked lists,
+// caches, external tilesets and templates) comes from 'scratch' and is never freed piecemeal: discard it in one go once
+// this returns. The finished map is then copied into a single block from 'persist', which must stay valid for as long
+// as the map is used. UnloadTMX() on the result unloads textures only; the block is released with 'persist'.
+// Returns NULL, with textures unloaded, if parsing fails or 'persist' is out of memory. Running out of 'scratch' is
+// fatal. Not reentrant: one load at a time.
+RAYTMX_DEC TmxMap *LoadTMXInto(const char *fileName, TmxAllocator persist, TmxAllocator scratch);
+
 // Unload a TMX map.
 RAYTMX_DEC void UnloadTMX(TmxMap *map);
 
@@ -714,15 +732,29 @@ RaytmxCachedTextureNode *LoadCachedTexture(RaytmxState *state, const char *fileN
 RaytmxCachedTemplateNode *LoadCachedTemplate(RaytmxState *state, const char *fileName);
 Color GetColorFromHexString(const char *hex);
 uint32_t GetGid(uint32_t rawGid, bool *flipX, bool *flipY, bool *flipDiag, bool *rotateHexag120);
-void *MemAllocZero(unsigned int size);
+void *RaytmxAlloc(unsigned int size);
+void *RaytmxAllocZero(unsigned int size);
+void RaytmxFree(void *buffer);
 const char *GetDirectoryPath2(const char *filePath);
 const char *JoinPath(const char *prefix, const char *suffix);
 void StringCopyN(char *destination, const char *source, size_t number);
 void StringConcatenate(char *destination, const char *source);
 
+// Offsets within a block being packed by PackMap(). 'block' is NULL during the measuring pass.
+typedef struct RaytmxPacker {
+    char *block;
+    size_t size;
+} RaytmxPacker;
+
+TmxMap *PackMap(RaytmxPacker *packer, TmxMap *map);
+void UnloadMapTextures(const TmxMap *map);
+
+// Allocator used by RaytmxAlloc() and RaytmxFree() while LoadTMXInto() runs. NULL means raylib's MemAlloc()/MemFree().
+static TmxAllocator *raytmxScratch = NULL;
+
 RAYTMX_DEC TmxMap *LoadTMX(const char *fileName)
 {
-    TmxMap *map = (TmxMap *)MemAllocZero(sizeof(TmxMap));
+    TmxMap *map = (TmxMap *)RaytmxAllocZero(sizeof(TmxMap));
     RaytmxState state;
     memset(&state, 0, sizeof(RaytmxState));
     state.format = FORMAT_TMX;
@@ -737,7 +769,7 @@ RAYTMX_DEC TmxMap *LoadTMX(const char *fileName)
     }
 
     // Copy some top-level map properties.
-    map->fileName = (char *)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    map->fileName = (char *)RaytmxAllocZero((unsigned int)strlen(fileName) + 1);
     StringCopy(map->fileName, GetFileName(fileName));
     map->orientation = state.mapOrientation;
     map->renderOrder = state.mapRenderOrder;
@@ -754,7 +786,7 @@ RAYTMX_DEC TmxMap *LoadTMX(const char *fileName)
     if (state.tilesetsRoot != NULL) // If there is at least one tileset.
     {
         // Allocate the array of tilesets and zeroize every index.
-        TmxTileset *tilesets = (TmxTileset *)MemAllocZero(sizeof(TmxTileset)*state.tilesetsLength);
+        TmxTileset *tilesets = (TmxTileset *)RaytmxAllocZero(sizeof(TmxTileset)*state.tilesetsLength);
 
         // Copy the TmxTileset pointers into the array.
         RaytmxTilesetNode *tilesetIter = state.tilesetsRoot;
@@ -801,7 +833,7 @@ RAYTMX_DEC TmxMap *LoadTMX(const char *fileName)
 
     if (gidsToTilesLength > 0)
     {
-        TmxTile *gidsToTiles = (TmxTile *)MemAllocZero(sizeof(TmxTile)*gidsToTilesLength);
+        TmxTile *gidsToTiles = (TmxTile *)RaytmxAllocZero(sizeof(TmxTile)*gidsToTilesLength);
 
         for (uint32_t i = 0; i < map->tilesetsLength; i++)
         {
@@ -915,33 +947,65 @@ RAYTMX_DEC TmxMap *LoadTMX(const char *fileName)
     return map;
 }
 
+RAYTMX_DEC TmxMap *LoadTMXInto(const char *fileName, TmxAllocator persist, TmxAllocator scratch)
+{
+    // The regular load, except every allocation, freed or not, comes from 'scratch' and frees do nothing.
+    raytmxScratch = &scratch;
+    TmxMap *parsed = LoadTMX(fileName);
+    raytmxScratch = NULL;
+    if (parsed == NULL) return NULL;
+
+    // Size the block with a dry run of the copy, then copy for real.
+    RaytmxPacker packer = { ZERO_INIT };
+    PackMap(&packer, parsed);
+    char *block = (char *)persist.alloc(persist.user, packer.size);
+    if (block == NULL)
+    {
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to allocate %zu bytes for \"%s\"", packer.size, fileName);
+        UnloadMapTextures(parsed);
+        return NULL;
+    }
+
+    packer.block = block;
+    packer.size = 0;
+    TmxMap *map = PackMap(&packer, parsed);
+    map->isPacked = true;
+    return map;
+}
+
 RAYTMX_DEC void UnloadTMX(TmxMap *map)
 {
     if (map == NULL) return;
 
-    if (map->fileName != NULL) MemFree(map->fileName);
+    if (map->isPacked) // If the memory belongs to whoever called LoadTMXInto(), only the textures are ours.
+    {
+        UnloadMapTextures(map);
+        return;
+    }
+
+    if (map->fileName != NULL) RaytmxFree(map->fileName);
 
     if (map->properties != NULL)
     {
         for (uint32_t i = 0; i < map->propertiesLength; i++) FreeProperty(map->properties[i]);
-        MemFree(map->properties);
+        RaytmxFree(map->properties);
     }
 
     if (map->tilesets != NULL)
     {
         for (uint32_t i = 0; i < map->tilesetsLength; i++) FreeTileset(map->tilesets[i]);
-        MemFree(map->tilesets);
+        RaytmxFree(map->tilesets);
     }
 
     if (map->layers != NULL)
     {
         for (uint32_t i = 0; i < map->layersLength; i++) FreeLayer(map->layers[i]);
-        MemFree(map->layers);
+        RaytmxFree(map->layers);
     }
 
-    if (map->gidsToTiles != NULL) MemFree(map->gidsToTiles);
+    if (map->gidsToTiles != NULL) RaytmxFree(map->gidsToTiles);
 
-    MemFree(map);
+    RaytmxFree(map);
 }
 
 RAYTMX_DEC void DrawTMX(const TmxMap *map, const Camera2D *camera, const Rectangle *viewport, int posX, int posY,
@@ -1349,7 +1413,7 @@ void ParseDocument(RaytmxState *state, const char *fileName)
 
     hoxml_context_t hoxml = { ZERO_INIT };
     size_t bufferLength = contentLength;
-    char *buffer = (char *)MemAlloc((unsigned int)bufferLength);
+    char *buffer = (char *)RaytmxAlloc((unsigned int)bufferLength);
     hoxml_init(&hoxml, buffer, bufferLength);
 
     hoxml_code_t code;
@@ -1376,9 +1440,9 @@ void ParseDocument(RaytmxState *state, const char *fileName)
                     // This is one we can recover from by expanding the buffer. In this case, it will be doubled.
                     TraceLog(LOG_DEBUG, "RAYTMX: Allocating a new XML parsing buffer due to insufficient memory");
                     bufferLength *= 2;
-                    char *newBuffer = (char *)MemAlloc((unsigned int)bufferLength);
+                    char *newBuffer = (char *)RaytmxAlloc((unsigned int)bufferLength);
                     hoxml_realloc(&hoxml, newBuffer, bufferLength);
-                    MemFree(buffer);
+                    RaytmxFree(buffer);
                     buffer = newBuffer;
                 } continue;
                 case HOXML_ERROR_UNEXPECTED_EOF: TraceLog(LOG_ERROR, "RAYTMX: Unexpected end of file"); break;
@@ -1411,7 +1475,7 @@ void ParseDocument(RaytmxState *state, const char *fileName)
     }
 
     UnloadFileText(content);
-    MemFree(buffer);
+    RaytmxFree(buffer);
     state->isSuccess = true;
 }
 
@@ -1543,7 +1607,7 @@ void HandleElementBegin(RaytmxState *state, hoxml_context_t *hoxml)
         if (state->object != NULL)
         {
             state->object->type = OBJECT_TYPE_TEXT;
-            state->object->text = (TmxText *)MemAllocZero(sizeof(TmxText));
+            state->object->text = (TmxText *)RaytmxAllocZero(sizeof(TmxText));
 
             // There are a couple non-zero default values for <text> attributes.
             state->object->text->pixelSize = 16;
@@ -1605,7 +1669,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
         {
             if (strcmp(hoxml->attribute, "name") == 0)
             {
-                state->property->name = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->property->name = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->property->name, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "type") == 0)
@@ -1626,7 +1690,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
                 // In that case, doing a cast/conversion now may not be possible. To avoid this, the raw string value is
                 // copied to 'stringValue' temporarily, or permanently for string and file types, and the
                 // cast/conversion will happen at the end of the element if needed.
-                state->property->stringValue = (char *)MemAlloc((unsigned int)strlen(hoxml->value) + 1);
+                state->property->stringValue = (char *)RaytmxAlloc((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->property->stringValue, hoxml->value);
             }
         }
@@ -1638,7 +1702,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             if (strcmp(hoxml->attribute, "firstgid") == 0) state->tileset->firstGid = atoi(hoxml->value);
             else if (strcmp(hoxml->attribute, "source") == 0)
             {
-                state->tileset->source = (char *)MemAlloc((unsigned int)strlen(hoxml->value) + 1);
+                state->tileset->source = (char *)RaytmxAlloc((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tileset->source, hoxml->value);
                 // 'source' points to an external TSX file that defines the majority of the tileset. Try to load it.
                 RaytmxExternalTileset externalTileset = LoadTSX(JoinPath(state->documentDirectory, hoxml->value));
@@ -1659,12 +1723,12 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             }
             else if (strcmp(hoxml->attribute, "name") == 0)
             {
-                state->tileset->name = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->tileset->name = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tileset->name, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "class") == 0)
             {
-                state->tileset->classString = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->tileset->classString = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tileset->classString, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "tilewidth") == 0) state->tileset->tileWidth = atoi(hoxml->value);
@@ -1712,7 +1776,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
         {
             if (strcmp(hoxml->attribute, "source") == 0)
             {
-                state->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->image->source = (char*)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->image->source, hoxml->value);
                 RaytmxCachedTextureNode *cachedTexture = LoadCachedTexture(state, hoxml->value);
                 if (cachedTexture != NULL) state->image->texture = cachedTexture->texture;
@@ -1733,7 +1797,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             if (strcmp(hoxml->attribute, "id") == 0) state->tilesetTile->id = atoi(hoxml->value);
             else if ((strcmp(hoxml->attribute, "type") == 0) || (strcmp(hoxml->attribute, "class") == 0))
             {
-                state->tilesetTile->classString = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->tilesetTile->classString = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tilesetTile->classString, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "x") == 0) state->tilesetTile->x = atoi(hoxml->value);
@@ -1768,12 +1832,12 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
         {
             if (strcmp(hoxml->attribute, "encoding") == 0)
             {
-                state->tileLayer->encoding = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->tileLayer->encoding = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tileLayer->encoding, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "compression") == 0)
             {
-                state->tileLayer->compression = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->tileLayer->compression = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->tileLayer->compression, hoxml->value);
             }
         }
@@ -1813,12 +1877,12 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             if (strcmp(hoxml->attribute, "id") == 0) state->object->id = atoi(hoxml->value);
             else if (strcmp(hoxml->attribute, "name") == 0)
             {
-                state->object->name = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->object->name = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->object->name, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "type") == 0)
             {
-                state->object->typeString = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->object->typeString = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->object->typeString, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "x") == 0) state->object->x = atof(hoxml->value);
@@ -1835,7 +1899,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             else if (strcmp(hoxml->attribute, "visible") == 0) state->object->visible = atoi(hoxml->value) != 0;
             else if (strcmp(hoxml->attribute, "template") == 0)
             {
-                state->object->templateString = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->object->templateString = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->object->templateString, hoxml->value);
             }
         }
@@ -1892,7 +1956,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
                 y[terminator - iter] = '\0';
 
                 // Create a linked list node to hold the point and append it to the linked list.
-                RaytmxPolyPointNode *node = (RaytmxPolyPointNode *)MemAllocZero(sizeof(RaytmxPolyPointNode));
+                RaytmxPolyPointNode *node = (RaytmxPolyPointNode *)RaytmxAllocZero(sizeof(RaytmxPolyPointNode));
                 // Note: These values may be negative. A poly(gon|line) object's position is determined by the first
                 // vertex added leading to the first entry to be "0,0" and all other vertices relative to it.
                 node->point.x = (float)atof(x);
@@ -1922,7 +1986,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
                 }
 
                 // Allocate the array and assign NULL to every index to be safe.
-                Vector2 *points = (Vector2 *)MemAllocZero(sizeof(Vector2)*pointsLength);
+                Vector2 *points = (Vector2 *)RaytmxAllocZero(sizeof(Vector2)*pointsLength);
                 if (isPolygon) // If the centroid should be included as a vertex.
                 {
                     // Finish calculating the centroid by averaging the sum of the vertices keeping in mind that
@@ -1940,7 +2004,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
                     RaytmxPolyPointNode *parent = nodeIter;
                     nodeIter = nodeIter->next;
                     i += 1;
-                    MemFree(parent);
+                    RaytmxFree(parent);
                 }
 
                 // End the list with the first point. Both polygons and polylines use this when drawing.
@@ -1949,7 +2013,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
                 // TODO: Sort the vertices into counter-clockwise order as DrawTriangleFan() requires it.
                 state->object->points = points;
                 state->object->pointsLength = pointsLength;
-                state->object->drawPoints = (Vector2 *)MemAllocZero(sizeof(Vector2)*pointsLength);
+                state->object->drawPoints = (Vector2 *)RaytmxAllocZero(sizeof(Vector2)*pointsLength);
             }
         }
     }
@@ -1959,7 +2023,7 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
         {
             if (strcmp(hoxml->attribute, "fontfamily") == 0)
             {
-                state->object->text->fontFamily = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->object->text->fontFamily = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->object->text->fontFamily, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "pixelsize") == 0) state->object->text->pixelSize = atoi(hoxml->value);
@@ -2008,12 +2072,12 @@ void HandleAttribute(RaytmxState *state, hoxml_context_t *hoxml)
             if (strcmp(hoxml->attribute, "id") == 0) state->layer->id = atoi(hoxml->value);
             else if (strcmp(hoxml->attribute, "name") == 0)
             {
-                state->layer->name = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->layer->name = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->layer->name, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "class") == 0)
             {
-                state->layer->classString = (char *)MemAllocZero((unsigned int)strlen(hoxml->value) + 1);
+                state->layer->classString = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->value) + 1);
                 StringCopy(state->layer->classString, hoxml->value);
             }
             else if (strcmp(hoxml->attribute, "opacity") == 0) state->layer->opacity = atof(hoxml->value);
@@ -2048,13 +2112,13 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             if (layer->name == NULL) // If this layer didn't have a 'name' attribute.
             {
                 // The default value for 'name' is "" (an empty string).
-                layer->name = (char *)MemAlloc(1);
+                layer->name = (char *)RaytmxAlloc(1);
                 layer->name[0] = '\0';
             }
             if (layer->classString == NULL) // If this layer didn't have a 'class' attribute.
             {
                 // The default value for 'class' is "" (an empty string).
-                layer->classString = (char *)MemAlloc(1);
+                layer->classString = (char *)RaytmxAlloc(1);
                 layer->classString[0] = '\0';
             }
         }
@@ -2071,7 +2135,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
         if (state->propertiesDepth > 0) return; // If the outermost <properties> has not yet ended.
 
         // Allocate the array and assign NULL to every index to be safe.
-        TmxProperty *properties = (TmxProperty *)MemAllocZero(sizeof(TmxProperty)*state->propertiesLength);
+        TmxProperty *properties = (TmxProperty *)RaytmxAllocZero(sizeof(TmxProperty)*state->propertiesLength);
 
         // Copy the TmxProperty pointers into the array and free the nodes while we're at it.
         RaytmxPropertyNode *iter = state->propertiesRoot;
@@ -2080,7 +2144,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             properties[i] = iter->property;
             RaytmxPropertyNode *parent = iter;
             iter = iter->next;
-            MemFree(parent);
+            RaytmxFree(parent);
         }
 
         // Add the properties array to the element it applies to.
@@ -2147,13 +2211,13 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                             // From the documentation: "When a string property contains newlines, the current version of
                             // Tiled will write out the value as characters contained inside the property element rather
                             // than as the value attribute."
-                            state->property->stringValue = (char *)MemAlloc((unsigned int)strlen(hoxml->content) + 1);
+                            state->property->stringValue = (char *)RaytmxAlloc((unsigned int)strlen(hoxml->content) + 1);
                             StringCopy(state->property->stringValue, hoxml->content);
                         }
                         else // If the string's value was neither provided as an attribute nor content.
                         {
                             // The default value for 'string' is an empty string.
-                            state->property->stringValue = (char *)MemAlloc(1);
+                            state->property->stringValue = (char *)RaytmxAlloc(1);
                             state->property->stringValue[0] = '\0';
                         }
                     }
@@ -2187,7 +2251,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     // The default value for 'file' is ".".
                     if (state->property->stringValue == NULL)
                     {
-                        state->property->stringValue = (char *)MemAlloc(2);
+                        state->property->stringValue = (char *)RaytmxAlloc(2);
                         state->property->stringValue[0] = '.';
                         state->property->stringValue[1] = '\0';
                     }
@@ -2200,7 +2264,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             {
                 // Properties of types other than 'string' and 'file' are placed in 'stringValue' temporarily. Now that
                 // they have been cast and assigned appropriately, 'stringValue' can be freed.
-                MemFree(state->property->stringValue);
+                RaytmxFree(state->property->stringValue);
                 state->property->stringValue = NULL;
             }
         }
@@ -2214,14 +2278,14 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             if (state->tileset->name == NULL) // If this <tileset> didn't have a 'name' attribute.
             {
                 // The default value for 'name' is "" (an empty string).
-                state->tileset->name = (char *)MemAlloc(1);
+                state->tileset->name = (char *)RaytmxAlloc(1);
                 state->tileset->name[0] = '\0';
             }
 
             if (state->tileset->classString == NULL) // If this <tileset> didn't have a 'class' attribute.
             {
                 // The default value for 'class' is "" (an empty string).
-                state->tileset->classString = (char *)MemAlloc(1);
+                state->tileset->classString = (char *)RaytmxAlloc(1);
                 state->tileset->classString[0] = '\0';
             }
 
@@ -2238,7 +2302,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             {
                 // Allocate the array and zeroize every index as initialization.
                 TmxTilesetTile *tiles =
-                    (TmxTilesetTile *)MemAllocZero(sizeof(TmxTilesetTile)*state->tilesetTilesLength);
+                    (TmxTilesetTile *)RaytmxAllocZero(sizeof(TmxTilesetTile)*state->tilesetTilesLength);
                 // Copy the TmxTilesetTile pointers into the array and free the nodes while we're at it.
                 RaytmxTilesetTileNode *iter = state->tilesetTilesRoot;
                 for (uint32_t i = 0; (i < state->tilesetTilesLength) && (iter != NULL); i++)
@@ -2246,7 +2310,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     tiles[i] = iter->tile;
                     RaytmxTilesetTileNode *parent = iter;
                     iter = iter->next;
-                    MemFree(parent);
+                    RaytmxFree(parent);
                 }
 
                 // Add the tiles array to the tileset.
@@ -2270,7 +2334,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
             // Allocate the array and zeroize every index as initialization.
             TmxAnimationFrame *frames =
-                (TmxAnimationFrame *)MemAllocZero(sizeof(TmxAnimationFrame)*state->animationFramesLength);
+                (TmxAnimationFrame *)RaytmxAllocZero(sizeof(TmxAnimationFrame)*state->animationFramesLength);
             // Copy the TmxAnimationFrame pointers into the array and free the nodes while we're at it.
             RaytmxAnimationFrameNode *iter = state->animationFramesRoot;
             for (uint32_t i = 0; iter != NULL; i++)
@@ -2278,7 +2342,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 frames[i] = iter->frame;
                 RaytmxAnimationFrameNode *parent = iter;
                 iter = iter->next;
-                MemFree(parent);
+                RaytmxFree(parent);
             }
 
             // Add the frames array to the tile's animation.
@@ -2307,13 +2371,13 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 {
                     RaytmxTileLayerTileNode *parent = iter;
                     iter = iter->next;
-                    MemFree(parent);
+                    RaytmxFree(parent);
                 }
             }
             else
             {
                 // Allocate the array and zeroize every index as initialization.
-                uint32_t *tiles = (uint32_t *)MemAllocZero(sizeof(uint32_t)*state->layerTilesLength);
+                uint32_t *tiles = (uint32_t *)RaytmxAllocZero(sizeof(uint32_t)*state->layerTilesLength);
                 // Copy the GID into the array and free the nodes while we're at it.
                 RaytmxTileLayerTileNode *iter = state->layerTilesRoot;
                 for (uint32_t i = 0;  iter != NULL; i++)
@@ -2321,7 +2385,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     tiles[i] = iter->gid;
                     RaytmxTileLayerTileNode *parent = iter;
                     iter = iter->next;
-                    MemFree(parent);
+                    RaytmxFree(parent);
                 }
 
                 // Add the tiles array to the tile layer.
@@ -2345,7 +2409,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             if (state->tilesetTile->classString == NULL) // If this <tile> didn't have a 'class' attribute.
             {
                 // The default value for 'class' is "" (an empty string).
-                state->tilesetTile->classString = (char *)MemAlloc(1);
+                state->tilesetTile->classString = (char *)RaytmxAlloc(1);
                 state->tilesetTile->classString[0] = '\0';
             }
 
@@ -2386,7 +2450,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
                 // Copy the Base64 string into a dedicated buffer without whitespace appropriate for decoding.
                 const size_t length = (size_t)(encodedEnd - encodedStart + 1);
-                char *base64 = (char *)MemAllocZero((unsigned int)length + 1); // +1 for the null terminator.
+                char *base64 = (char *)RaytmxAllocZero((unsigned int)length + 1); // +1 for the null terminator.
                 StringCopyN(base64, encodedStart, length);
 
                 // With the string of encoded Base64 data trimmed, decode it.
@@ -2398,7 +2462,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 // Past versions of raylib, before 6.0, use 'const unsigned char *' for the first parameter.
                 unsigned char *decoded = DecodeDataBase64((const unsigned char *)base64, &decodedLength);
 #endif
-                MemFree(base64); // Free the dedicated Base64 buffer. It's no longer needed.
+                RaytmxFree(base64); // Free the dedicated Base64 buffer. It's no longer needed.
                 if (decoded != NULL)
                 {
                     if (state->tileLayer->compression == NULL) // If the Base64-encoded data is uncompressed.
@@ -2517,7 +2581,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
             if (tiles != NULL) // If there was no error in parsing the data and there's a linked list of tiles.
             {
-                uint32_t *tiles = (uint32_t *)MemAllocZero(sizeof(uint32_t)*state->layerTilesLength);
+                uint32_t *tiles = (uint32_t *)RaytmxAllocZero(sizeof(uint32_t)*state->layerTilesLength);
 
                 // Copy the GIDs into the array and free the nodes while we're at it.
                 RaytmxTileLayerTileNode *layerTilesIter = state->layerTilesRoot;
@@ -2526,7 +2590,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     tiles[i] = layerTilesIter->gid;
                     RaytmxTileLayerTileNode *layerTilesTemp = layerTilesIter;
                     layerTilesIter = layerTilesIter->next;
-                    MemFree(layerTilesTemp);
+                    RaytmxFree(layerTilesTemp);
                 }
 
                 // Add the tiles array to the element it applies to.
@@ -2547,8 +2611,8 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             if (state->objectsRoot == NULL) return;
 
             // Allocate the arrays and zeroize every index as initialization.
-            TmxObject *objects = (TmxObject *)MemAllocZero(sizeof(TmxObject)*state->objectsLength);
-            uint32_t *ySortedObjects = (uint32_t *)MemAllocZero(sizeof(uint32_t)*state->objectsLength);
+            TmxObject *objects = (TmxObject *)RaytmxAllocZero(sizeof(TmxObject)*state->objectsLength);
+            uint32_t *ySortedObjects = (uint32_t *)RaytmxAllocZero(sizeof(uint32_t)*state->objectsLength);
 
             // Create a contiguous array of TmxObjects, create a sorted linked list of indexes within that array of
             // TmxObjects (sorted by ascending Y coordinate), and free the object linked list.
@@ -2563,7 +2627,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 objects[i] = objectsIter->object;
 
                 // Add a new node into the sorted list.
-                newSortingNode = (RaytmxObjectSortingNode *)MemAllocZero(sizeof(RaytmxObjectSortingNode));
+                newSortingNode = (RaytmxObjectSortingNode *)RaytmxAllocZero(sizeof(RaytmxObjectSortingNode));
                 newSortingNode->y = objects[i].y;
                 newSortingNode->index = i;
                 if (sortingRoot == NULL) sortingRoot = newSortingNode; // If this is the first node.
@@ -2584,7 +2648,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 // Free the object node.
                 objectsTemp = objectsIter;
                 objectsIter = objectsIter->next;
-                MemFree(objectsTemp);
+                RaytmxFree(objectsTemp);
             }
 
             // Create a contiguous array from the sorted linked list such that index 0 of this array points to the
@@ -2595,7 +2659,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 ySortedObjects[i] = sortingIter->index;
                 sortingTemp = sortingIter;
                 sortingIter = sortingIter->next;
-                MemFree(sortingTemp);
+                RaytmxFree(sortingTemp);
             }
 
             // Add the 'objects' and 'ySortedObjects' array to the object layer.
@@ -2619,14 +2683,14 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
             if (state->object->name == NULL) // If this <object> didn't have a 'name' attribute.
             {
                 // The default value for 'name' is "" (an empty string).
-                state->object->name = (char *)MemAlloc(1);
+                state->object->name = (char *)RaytmxAlloc(1);
                 state->object->name[0] = '\0';
             }
 
             if (state->object->typeString == NULL) // If this <object> didn't have a 'type' attribute.
             {
                 // The default value for 'type' is "" (an empty string).
-                state->object->typeString = (char *)MemAlloc(1);
+                state->object->typeString = (char *)RaytmxAlloc(1);
                 state->object->typeString[0] = '\0';
             }
 
@@ -2649,14 +2713,14 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     if ((objectTemplate.object.name != NULL) && (state->object->name == NULL))
                     {
                         state->object->name =
-                            (char *)MemAllocZero((unsigned int)strlen(objectTemplate.object.name) + 1);
+                            (char *)RaytmxAllocZero((unsigned int)strlen(objectTemplate.object.name) + 1);
                         StringCopy(state->object->name, objectTemplate.object.name);
                     }
 
                     if ((objectTemplate.object.typeString != NULL) && (state->object->typeString != NULL))
                     {
                         state->object->typeString =
-                            (char *)MemAllocZero((unsigned int)strlen(objectTemplate.object.typeString) + 1);
+                            (char *)RaytmxAllocZero((unsigned int)strlen(objectTemplate.object.typeString) + 1);
                         StringCopy(state->object->typeString, objectTemplate.object.typeString);
                     }
 
@@ -2701,7 +2765,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                             // Add the properties from the instanced <object>.
                             for (uint32_t i = 0; i < state->object->propertiesLength; i++)
                             {
-                                node = (RaytmxPropertyNode *)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                node = (RaytmxPropertyNode *)RaytmxAllocZero(sizeof(RaytmxPropertyNode));
                                 node->property = state->object->properties[i];
                                 if (propertiesRoot == NULL) propertiesRoot = node;
                                 else propertiesTail->next = node;
@@ -2727,7 +2791,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
                                 if (isNew)
                                 {
-                                    node = (RaytmxPropertyNode *)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                    node = (RaytmxPropertyNode *)RaytmxAllocZero(sizeof(RaytmxPropertyNode));
                                     node->property = objectTemplate.object.properties[i];
                                     if (propertiesRoot == NULL) propertiesRoot = node;
                                     else propertiesTail->next = node;
@@ -2737,11 +2801,11 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                             }
 
                             // Free the separate array that was previously allocated.
-                            MemFree(state->object->properties);
+                            RaytmxFree(state->object->properties);
 
                             // Allocate a new array to be populated with the merged properties */
                             state->object->properties =
-                                (TmxProperty *)MemAllocZero(sizeof(TmxProperty)*propertiesLength);
+                                (TmxProperty *)RaytmxAllocZero(sizeof(TmxProperty)*propertiesLength);
                             state->object->propertiesLength = propertiesLength;
 
                             // Copy the TmxProperty entires into the array and free the nodes while we're at it.
@@ -2751,7 +2815,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                                 state->object->properties[i] = propertiesIter->property;
                                 RaytmxPropertyNode *propertiesTemp = propertiesIter;
                                 propertiesIter = propertiesIter->next;
-                                MemFree(propertiesTemp);
+                                RaytmxFree(propertiesTemp);
                             }
                         }
                     }
@@ -2821,14 +2885,14 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
             if (hoxml->content != NULL) // If the element had content e.g. <text>Content here</text>.
             {
-                objectText->content = (char *)MemAllocZero((unsigned int)strlen(hoxml->content) + 1);
+                objectText->content = (char *)RaytmxAllocZero((unsigned int)strlen(hoxml->content) + 1);
                 StringCopy(objectText->content, hoxml->content);
             }
 
             if (objectText->fontFamily == NULL) // If this <text> didn't have a 'fontfamily' attribute.
             {
                 // The default value for 'fontfamily' is "sans-serif".
-                objectText->fontFamily = (char *)MemAllocZero((unsigned int)strlen("sans-serif") + 1);
+                objectText->fontFamily = (char *)RaytmxAllocZero((unsigned int)strlen("sans-serif") + 1);
                 StringCopy(objectText->fontFamily, "sans-serif");
             }
 
@@ -2846,11 +2910,11 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                 const unsigned int bufferLength = (unsigned int)strlen(objectText->content) + 1;
                 // This buffer will hold hold subsets of the content while iterating through it. The string in this
                 // buffer may exceed the bounds.
-                char *testingBuffer = (char *)MemAllocZero(bufferLength);
+                char *testingBuffer = (char *)RaytmxAllocZero(bufferLength);
                 // This one will hold the last known good string whose graphical text would fit within the bounds.
-                char *validBuffer = (char *)MemAllocZero(bufferLength);
+                char *validBuffer = (char *)RaytmxAllocZero(bufferLength);
                 // This one will hold space-delimited subsets of the above.
-                char *delimitedBuffer = (char *)MemAllocZero(bufferLength);
+                char *delimitedBuffer = (char *)RaytmxAllocZero(bufferLength);
                 bool isDelimited = false;
 
                 char *start = objectText->content;
@@ -2925,13 +2989,13 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                         end = start;
 
                         TmxTextLine line = { ZERO_INIT };
-                        line.content = (char *)MemAllocZero((unsigned int)strlen(sourceBuffer) + 1);
+                        line.content = (char *)RaytmxAllocZero((unsigned int)strlen(sourceBuffer) + 1);
                         StringCopy(line.content, sourceBuffer);
                         line.font = font;
                         line.spacing = spacing;
                         // Note: The number of lines is not yet known but needs to be for Y positioning.
 
-                        RaytmxTextLineNode *node = (RaytmxTextLineNode *)MemAllocZero(sizeof(RaytmxTextLineNode));
+                        RaytmxTextLineNode *node = (RaytmxTextLineNode *)RaytmxAllocZero(sizeof(RaytmxTextLineNode));
                         node->line = line;
                         if (linesRoot == NULL) linesRoot = node;
                         else linesTail->next = node;
@@ -2953,14 +3017,14 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                     }
                 }
 
-                MemFree(testingBuffer);
-                MemFree(validBuffer);
-                MemFree(delimitedBuffer);
+                RaytmxFree(testingBuffer);
+                RaytmxFree(validBuffer);
+                RaytmxFree(delimitedBuffer);
 
                 if (linesRoot != NULL)
                 {
                     // Allocate the array and zero out every value as initialization.
-                    TmxTextLine *lines = (TmxTextLine *)MemAllocZero(sizeof(TmxTextLine)*linesLength);
+                    TmxTextLine *lines = (TmxTextLine *)RaytmxAllocZero(sizeof(TmxTextLine)*linesLength);
                     // Copy the TmxTextLines into the array and free the nodes while we're at it.
                     RaytmxTextLineNode *iter = linesRoot;
                     for (uint32_t i = 0; (i < linesLength) && (iter != NULL); i++)
@@ -3001,7 +3065,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
                                 // Create a new string with the additional space.
                                 const size_t justifiedLength = length + (numSpacesToAddPer*numSpaces);
-                                char *justifiedContent = (char *)MemAllocZero((unsigned int)justifiedLength + 1);
+                                char *justifiedContent = (char *)RaytmxAllocZero((unsigned int)justifiedLength + 1);
                                 uint32_t sourceIndex = 0;
                                 uint32_t destinationIndex = 0;
                                 while (lines[i].content[sourceIndex] != '\0')
@@ -3020,7 +3084,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
                                 }
 
                                 // Free the original content buffer and replace it with the justified one.
-                                MemFree(lines[i].content);
+                                RaytmxFree(lines[i].content);
                                 lines[i].content = justifiedContent;
                                 length = justifiedLength;
                             }
@@ -3052,7 +3116,7 @@ void HandleElementEnd(RaytmxState *state, hoxml_context_t *hoxml)
 
                         RaytmxTextLineNode *parent = iter;
                         iter = iter->next;
-                        MemFree(parent);
+                        RaytmxFree(parent);
                     }
 
                     // Add the lines array to the text object.
@@ -3086,7 +3150,7 @@ void FreeStateLayers(RaytmxLayerNode *layers)
         // Iterate to the next node and free this one.
         layersTemp = layersIter;
         layersIter = layersIter->next;
-        MemFree(layersTemp);
+        RaytmxFree(layersTemp);
     }
 }
 
@@ -3102,8 +3166,8 @@ void FreeState(RaytmxState *state)
     {
         cachedTextureTemp = cachedTextureIter;
         cachedTextureIter = cachedTextureIter->next;
-        if (cachedTextureTemp->fileName != NULL) MemFree(cachedTextureTemp->fileName);
-        MemFree(cachedTextureTemp);
+        if (cachedTextureTemp->fileName != NULL) RaytmxFree(cachedTextureTemp->fileName);
+        RaytmxFree(cachedTextureTemp);
     }
     state->texturesRoot = NULL;
 
@@ -3114,8 +3178,8 @@ void FreeState(RaytmxState *state)
         cachedTemplateTemp = cachedTemplateIter;
         cachedTemplateIter = cachedTemplateIter->next;
         FreeObject(cachedTemplateTemp->objectTemplate.object);
-        if (cachedTemplateTemp->fileName != NULL) MemFree(cachedTemplateTemp->fileName);
-        MemFree(cachedTemplateTemp);
+        if (cachedTemplateTemp->fileName != NULL) RaytmxFree(cachedTemplateTemp->fileName);
+        RaytmxFree(cachedTemplateTemp);
     }
     state->templatesRoot = NULL;
 
@@ -3139,7 +3203,7 @@ void FreeState(RaytmxState *state)
     {
         propertiesTemp = propertiesIter;
         propertiesIter = propertiesIter->next;
-        MemFree(propertiesTemp);
+        RaytmxFree(propertiesTemp);
     }
     // Zeroize this linked list's properties.
     state->propertiesRoot = NULL;
@@ -3153,7 +3217,7 @@ void FreeState(RaytmxState *state)
     {
         tilesetsTemp = tilesetsIter;
         tilesetsIter = tilesetsIter->next;
-        MemFree(tilesetsTemp);
+        RaytmxFree(tilesetsTemp);
     }
     // Zeroize this linked list's properties.
     state->tilesetsRoot = NULL;
@@ -3167,7 +3231,7 @@ void FreeState(RaytmxState *state)
     {
         tilesetTilesTemp = tilesetTilesIter;
         tilesetTilesIter = tilesetTilesIter->next;
-        MemFree(tilesetTilesTemp);
+        RaytmxFree(tilesetTilesTemp);
     }
     // Zeroize this linked list's properties.
     state->tilesetTilesRoot = NULL;
@@ -3181,7 +3245,7 @@ void FreeState(RaytmxState *state)
     {
         animationFramesTemp = animationFramesIter;
         animationFramesIter = animationFramesIter->next;
-        MemFree(animationFramesTemp);
+        RaytmxFree(animationFramesTemp);
     }
     // Zeroize this linked list's properties.
     state->animationFramesRoot = NULL;
@@ -3203,7 +3267,7 @@ void FreeState(RaytmxState *state)
     {
         layerTilesTemp = layerTilesIter;
         layerTilesIter = layerTilesIter->next;
-        MemFree(layerTilesTemp);
+        RaytmxFree(layerTilesTemp);
     }
     // Zeroize this linked list's properties.
     state->layerTilesRoot = NULL;
@@ -3217,7 +3281,7 @@ void FreeState(RaytmxState *state)
     {
         objectsTemp = objectsIter;
         objectsIter = objectsIter->next;
-        MemFree(objectsTemp);
+        RaytmxFree(objectsTemp);
     }
     // Zeroize this linked list's properties.
     state->objectsRoot = NULL;
@@ -3227,7 +3291,7 @@ void FreeState(RaytmxState *state)
 
 inline void FreeString(char *str)
 {
-    if (str != NULL) MemFree(str);
+    if (str != NULL) RaytmxFree(str);
 }
 
 void FreeTileset(TmxTileset tileset)
@@ -3245,7 +3309,7 @@ void FreeTileset(TmxTileset tileset)
     if (tileset.properties != NULL)
     {
         for (uint32_t i = 0; i < tileset.propertiesLength; i++) FreeProperty(tileset.properties[i]);
-        MemFree(tileset.properties);
+        RaytmxFree(tileset.properties);
     }
 
     for (uint32_t i = 0; i < tileset.tilesLength; i++)
@@ -3260,11 +3324,11 @@ void FreeTileset(TmxTileset tileset)
             if (tile.properties != NULL)
             {
                 for (uint32_t j = 0; j < tile.propertiesLength; j++) FreeProperty(tile.properties[j]);
-                MemFree(tile.properties);
+                RaytmxFree(tile.properties);
             }
         }
 
-        if (tile.animation.frames != NULL) MemFree(tile.animation.frames);
+        if (tile.animation.frames != NULL) RaytmxFree(tile.animation.frames);
     }
 }
 
@@ -3282,7 +3346,7 @@ void FreeLayer(TmxLayer layer)
     if (layer.properties != NULL)
     {
         for (uint32_t i = 0; i < layer.propertiesLength; i++) FreeProperty(layer.properties[i]);
-        MemFree(layer.properties);
+        RaytmxFree(layer.properties);
     }
 
     switch (layer.type)
@@ -3291,13 +3355,13 @@ void FreeLayer(TmxLayer layer)
         {
             FreeString(layer.exact.tileLayer.encoding);
             FreeString(layer.exact.tileLayer.compression);
-            MemFree(layer.exact.tileLayer.tiles);
+            RaytmxFree(layer.exact.tileLayer.tiles);
         } break;
         case LAYER_TYPE_OBJECT_GROUP:
         {
             for (uint32_t j = 0; j < layer.exact.objectGroup.objectsLength; j++)
                 FreeObject(layer.exact.objectGroup.objects[j]);
-            MemFree(layer.exact.objectGroup.objects);
+            RaytmxFree(layer.exact.objectGroup.objects);
         } break;
         case LAYER_TYPE_IMAGE_LAYER:
         {
@@ -3316,17 +3380,17 @@ void FreeObject(TmxObject object)
     FreeString(object.typeString);
     FreeString(object.templateString);
 
-    if (object.points != NULL) MemFree(object.points);
+    if (object.points != NULL) RaytmxFree(object.points);
 
     if (object.text != NULL)
     {
         if (object.text->lines != NULL)
         {
             for (uint32_t j = 0; j < object.text->linesLength; j++) FreeString(object.text->lines[j].content);
-            MemFree(object.text->lines);
+            RaytmxFree(object.text->lines);
         }
 
-        MemFree(object.text);
+        RaytmxFree(object.text);
     }
 }
 
@@ -4562,7 +4626,7 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces)
 
 TmxProperty *AddProperty(RaytmxState *state)
 {
-    RaytmxPropertyNode *node = (RaytmxPropertyNode *)MemAllocZero(sizeof(RaytmxPropertyNode));
+    RaytmxPropertyNode *node = (RaytmxPropertyNode *)RaytmxAllocZero(sizeof(RaytmxPropertyNode));
 
     // Use this node as the root if there is no root. Append it to the tail otherwise.
     if (state->propertiesRoot == NULL) state->propertiesRoot = node;
@@ -4575,7 +4639,7 @@ TmxProperty *AddProperty(RaytmxState *state)
 
 void AddTileLayerTile(RaytmxState *state, uint32_t gid)
 {
-    RaytmxTileLayerTileNode *node = (RaytmxTileLayerTileNode *)MemAllocZero(sizeof(RaytmxTileLayerTileNode));
+    RaytmxTileLayerTileNode *node = (RaytmxTileLayerTileNode *)RaytmxAllocZero(sizeof(RaytmxTileLayerTileNode));
     node->gid = gid;
 
     // Use this node as the root if there is no root. Append it to the tail otherwise.
@@ -4587,7 +4651,7 @@ void AddTileLayerTile(RaytmxState *state, uint32_t gid)
 
 TmxTileset *AddTileset(RaytmxState *state)
 {
-    RaytmxTilesetNode *node = (RaytmxTilesetNode *)MemAllocZero(sizeof(RaytmxTilesetNode));
+    RaytmxTilesetNode *node = (RaytmxTilesetNode *)RaytmxAllocZero(sizeof(RaytmxTilesetNode));
 
     // Use this node as the root if there is no root. Append it to the tail otherwise.
     if (state->tilesetsRoot == NULL) state->tilesetsRoot = node;
@@ -4600,7 +4664,7 @@ TmxTileset *AddTileset(RaytmxState *state)
 
 TmxTilesetTile *AddTilesetTile(RaytmxState *state)
 {
-    RaytmxTilesetTileNode *node = (RaytmxTilesetTileNode *)MemAllocZero(sizeof(RaytmxTilesetTileNode));
+    RaytmxTilesetTileNode *node = (RaytmxTilesetTileNode *)RaytmxAllocZero(sizeof(RaytmxTilesetTileNode));
 
     // Use this node as the root if there is no root. Append it to the tail otherwise.
     if (state->tilesetTilesRoot == NULL) state->tilesetTilesRoot = node;
@@ -4613,7 +4677,7 @@ TmxTilesetTile *AddTilesetTile(RaytmxState *state)
 
 TmxAnimationFrame *AddAnimationFrame(RaytmxState *state)
 {
-    RaytmxAnimationFrameNode *node = (RaytmxAnimationFrameNode *)MemAllocZero(sizeof(RaytmxAnimationFrameNode));
+    RaytmxAnimationFrameNode *node = (RaytmxAnimationFrameNode *)RaytmxAllocZero(sizeof(RaytmxAnimationFrameNode));
 
     // Use this node as the root if there is no root. Append it to the tail otherwise.
     if (state->animationFramesRoot == NULL) state->animationFramesRoot = node;
@@ -4626,7 +4690,7 @@ TmxAnimationFrame *AddAnimationFrame(RaytmxState *state)
 
 TmxLayer *AddGenericLayer(RaytmxState *state, bool isGroup)
 {
-    RaytmxLayerNode *node = (RaytmxLayerNode *)MemAllocZero(sizeof(RaytmxLayerNode));
+    RaytmxLayerNode *node = (RaytmxLayerNode *)RaytmxAllocZero(sizeof(RaytmxLayerNode));
     // There are some non-zero default values for several layer attributes.
     node->layer.opacity = 1.0;
     node->layer.visible = true;
@@ -4658,7 +4722,7 @@ TmxLayer *AddGenericLayer(RaytmxState *state, bool isGroup)
 
 TmxObject *AddObject(RaytmxState *state)
 {
-    RaytmxObjectNode *node = (RaytmxObjectNode *)MemAllocZero(sizeof(RaytmxObjectNode));
+    RaytmxObjectNode *node = (RaytmxObjectNode *)RaytmxAllocZero(sizeof(RaytmxObjectNode));
     // <object> elements have one non-zero default value.
     node->object.visible = true;
 
@@ -4679,7 +4743,7 @@ void AppendLayerTo(TmxMap *map, RaytmxLayerNode *groupNode, RaytmxLayerNode *lay
     if (groupNode != NULL) groupLayer = &(groupNode->layer);
 
     // Allocate the array and zerioze every index as initialization.
-    TmxLayer *layers = (TmxLayer *)MemAllocZero(sizeof(TmxLayer)*layersLength);
+    TmxLayer *layers = (TmxLayer *)RaytmxAllocZero(sizeof(TmxLayer)*layersLength);
 
     // Copy the TmxLayers into the array.
     RaytmxLayerNode *layersIter = layersRoot;
@@ -4727,8 +4791,8 @@ RaytmxCachedTextureNode *LoadCachedTexture(RaytmxState *raytmxState, const char
     }
 
     // Create a new node in the list of known textures.
-    cachedTextureNode = (RaytmxCachedTextureNode *)MemAllocZero(sizeof(RaytmxCachedTextureNode));
-    cachedTextureNode->fileName = (char *)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    cachedTextureNode = (RaytmxCachedTextureNode *)RaytmxAllocZero(sizeof(RaytmxCachedTextureNode));
+    cachedTextureNode->fileName = (char *)RaytmxAllocZero((unsigned int)strlen(fileName) + 1);
     StringCopy(cachedTextureNode->fileName, fileName);
     cachedTextureNode->texture = texture;
 
@@ -4769,8 +4833,8 @@ RaytmxCachedTemplateNode *LoadCachedTemplate(RaytmxState *raytmxState, const cha
     }
 
     // Create a new node in the list of known templates.
-    cachedTemplateNode = (RaytmxCachedTemplateNode *)MemAllocZero(sizeof(RaytmxCachedTemplateNode));
-    cachedTemplateNode->fileName = (char *)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    cachedTemplateNode = (RaytmxCachedTemplateNode *)RaytmxAllocZero(sizeof(RaytmxCachedTemplateNode));
+    cachedTemplateNode->fileName = (char *)RaytmxAllocZero((unsigned int)strlen(fileName) + 1);
     StringCopy(cachedTemplateNode->fileName, fileName);
     cachedTemplateNode->objectTemplate = objectTemplate;
 
@@ -4863,13 +4927,202 @@ uint32_t GetGid(uint32_t rawGid, bool *flipX, bool *flipY, bool *flipDiag, bool
     return rawGid & ~(FLIP_FLAG_HORIZONTAL | FLIP_FLAG_VERTICAL | FLIP_FLAG_DIAGONAL | FLIP_FLAG_ROTATE_120);
 }
 
-void *MemAllocZero(unsigned int size)
+void *RaytmxAlloc(unsigned int size)
 {
-    void *buffer = MemAlloc(size); // Reserve 'size' bytes of memory.
+    if (raytmxScratch == NULL) return MemAlloc(size);
+
+    void *buffer = raytmxScratch->alloc(raytmxScratch->user, size);
+    if (buffer == NULL) TraceLog(LOG_FATAL, "RAYTMX: Out of scratch memory allocating %u bytes", size);
+    return buffer;
+}
+
+void RaytmxFree(void *buffer)
+{
+    if (raytmxScratch == NULL) MemFree(buffer); // Scratch memory is discarded as a whole by the caller.
+}
+
+void *RaytmxAllocZero(unsigned int size)
+{
+    void *buffer = RaytmxAlloc(size); // Reserve 'size' bytes of memory.
     memset(buffer, 0, size); // Initialize any values to zero, NULL, false, or an equivalent enum value.
     return buffer;
 }
 
+// Alignment of every array and string within a packed map. Enough for the pointers and doubles in the models.
+#define RAYTMX_PACK_ALIGN 8
+
+// Reserves 'size' bytes of the packed block and copies 'source' into them. While measuring, only counts the bytes and
+// returns 'source' itself. The Pack*() functions below then rewrite pointers with the values they already hold, so the
+// same walk serves both passes.
+void *PackBytes(RaytmxPacker *packer, const void *source, size_t size)
+{
+    if (source == NULL) return NULL;
+
+    const size_t offset = (packer->size + RAYTMX_PACK_ALIGN - 1) & ~(size_t)(RAYTMX_PACK_ALIGN - 1);
+    packer->size = offset + size;
+    if (packer->block == NULL) return (void *)source;
+
+    memcpy(packer->block + offset, source, size);
+    return packer->block + offset;
+}
+
+char *PackString(RaytmxPacker *packer, const char *str)
+{
+    return (str == NULL)? NULL : (char *)PackBytes(packer, str, strlen(str) + 1);
+}
+
+void PackProperties(RaytmxPacker *packer, TmxProperty **properties, uint32_t propertiesLength)
+{
+    *properties = (TmxProperty *)PackBytes(packer, *properties, sizeof(TmxProperty)*propertiesLength);
+    for (uint32_t i = 0; (*properties != NULL) && (i < propertiesLength); i++)
+    {
+        (*properties)[i].name = PackString(packer, (*properties)[i].name);
+        (*properties)[i].stringValue = PackString(packer, (*properties)[i].stringValue);
+    }
+}
+
+void PackObjectGroup(RaytmxPacker *packer, TmxObjectGroup *group)
+{
+    group->objects = (TmxObject *)PackBytes(packer, group->objects, sizeof(TmxObject)*group->objectsLength);
+    group->ySortedObjects = (uint32_t *)PackBytes(packer, group->ySortedObjects,
+        sizeof(uint32_t)*group->objectsLength);
+
+    for (uint32_t i = 0; (group->objects != NULL) && (i < group->objectsLength); i++)
+    {
+        TmxObject *object = &(group->objects[i]);
+        object->name = PackString(packer, object->name);
+        object->typeString = PackString(packer, object->typeString);
+        object->templateString = PackString(packer, object->templateString);
+        object->points = (Vector2 *)PackBytes(packer, object->points, sizeof(Vector2)*object->pointsLength);
+        object->drawPoints = (Vector2 *)PackBytes(packer, object->drawPoints, sizeof(Vector2)*object->pointsLength);
+        PackProperties(packer, &(object->properties), object->propertiesLength);
+
+        if (object->text != NULL)
+        {
+            TmxText *text = (TmxText *)PackBytes(packer, object->text, sizeof(TmxText));
+            text->fontFamily = PackString(packer, text->fontFamily);
+            text->content = PackString(packer, text->content);
+            text->lines = (TmxTextLine *)PackBytes(packer, text->lines, sizeof(TmxTextLine)*text->linesLength);
+            for (uint32_t j = 0; (text->lines != NULL) && (j < text->linesLength); j++)
+                text->lines[j].content = PackString(packer, text->lines[j].content);
+            object->text = text;
+        }
+    }
+}
+
+void PackLayers(RaytmxPacker *packer, TmxLayer **layers, uint32_t layersLength)
+{
+    *layers = (TmxLayer *)PackBytes(packer, *layers, sizeof(TmxLayer)*layersLength);
+    for (uint32_t i = 0; (*layers != NULL) && (i < layersLength); i++)
+    {
+        TmxLayer *layer = &((*layers)[i]);
+        layer->name = PackString(packer, layer->name);
+        layer->classString = PackString(packer, layer->classString);
+        PackProperties(packer, &(layer->properties), layer->propertiesLength);
+
+        switch (layer->type)
+        {
+            case LAYER_TYPE_TILE_LAYER:
+            {
+                TmxTileLayer *tileLayer = &(layer->exact.tileLayer);
+                tileLayer->encoding = PackString(packer, tileLayer->encoding);
+                tileLayer->compression = PackString(packer, tileLayer->compression);
+                tileLayer->tiles = (uint32_t *)PackBytes(packer, tileLayer->tiles,
+                    sizeof(uint32_t)*tileLayer->tilesLength);
+            } break;
+            case LAYER_TYPE_OBJECT_GROUP: PackObjectGroup(packer, &(layer->exact.objectGroup)); break;
+            case LAYER_TYPE_IMAGE_LAYER:
+            {
+                TmxImage *image = &(layer->exact.imageLayer.image);
+                image->source = PackString(packer, image->source);
+            } break;
+            case LAYER_TYPE_GROUP: break; // Nothing to do for this case but compilers like to complain.
+        }
+
+        PackLayers(packer, &(layer->layers), layer->layersLength);
+    }
+}
+
+void PackTilesets(RaytmxPacker *packer, TmxTileset **tilesets, uint32_t tilesetsLength)
+{
+    *tilesets = (TmxTileset *)PackBytes(packer, *tilesets, sizeof(TmxTileset)*tilesetsLength);
+    for (uint32_t i = 0; (*tilesets != NULL) && (i < tilesetsLength); i++)
+    {
+        TmxTileset *tileset = &((*tilesets)[i]);
+        tileset->source = PackString(packer, tileset->source);
+        tileset->name = PackString(packer, tileset->name);
+        tileset->classString = PackString(packer, tileset->classString);
+        tileset->image.source = PackString(packer, tileset->image.source);
+        PackProperties(packer, &(tileset->properties), tileset->propertiesLength);
+
+        tileset->tiles = (TmxTilesetTile *)PackBytes(packer, tileset->tiles,
+            sizeof(TmxTilesetTile)*tileset->tilesLength);
+        for (uint32_t j = 0; (tileset->tiles != NULL) && (j < tileset->tilesLength); j++)
+        {
+            TmxTilesetTile *tile = &(tileset->tiles[j]);
+            tile->classString = PackString(packer, tile->classString);
+            tile->image.source = PackString(packer, tile->image.source);
+            tile->animation.frames = (TmxAnimationFrame *)PackBytes(packer, tile->animation.frames,
+                sizeof(TmxAnimationFrame)*tile->animation.framesLength);
+            PackProperties(packer, &(tile->properties), tile->propertiesLength);
+            PackObjectGroup(packer, &(tile->objectGroup));
+        }
+    }
+}
+
+// Copies 'map' and everything it points to into 'packer', or measures how many bytes that takes. Returns the copy.
+TmxMap *PackMap(RaytmxPacker *packer, TmxMap *map)
+{
+    map = (TmxMap *)PackBytes(packer, map, sizeof(TmxMap));
+    map->fileName = PackString(packer, map->fileName);
+    PackProperties(packer, &(map->properties), map->propertiesLength);
+    PackTilesets(packer, &(map->tilesets), map->tilesetsLength);
+    PackLayers(packer, &(map->layers), map->layersLength);
+    map->gidsToTiles = (TmxTile *)PackBytes(packer, map->gidsToTiles, sizeof(TmxTile)*map->gidsToTilesLength);
+
+    // LoadTMX() lets 'gidsToTiles' share animations and collision objects with the tiles of shared-image tilesets.
+    // Point them at the packed tiles rather than packing them twice.
+    for (uint32_t i = 0; (map->gidsToTiles != NULL) && (i < map->tilesetsLength); i++)
+    {
+        const TmxTileset *tileset = &(map->tilesets[i]);
+        if (!tileset->hasImage) continue;
+
+        for (uint32_t j = 0; j < tileset->tilesLength; j++)
+        {
+            const TmxTilesetTile *tile = &(tileset->tiles[j]);
+            TmxTile *gidTile = &(map->gidsToTiles[tileset->firstGid + tile->id]);
+            if (tile->hasAnimation) gidTile->animation = tile->animation;
+            gidTile->objectGroup = tile->objectGroup;
+        }
+    }
+
+    return map;
+}
+
+void UnloadLayerTextures(const TmxLayer *layers, uint32_t layersLength)
+{
+    for (uint32_t i = 0; i < layersLength; i++)
+    {
+        if ((layers[i].type == LAYER_TYPE_IMAGE_LAYER) && layers[i].exact.imageLayer.hasImage)
+            UnloadTexture(layers[i].exact.imageLayer.image.texture);
+        UnloadLayerTextures(layers[i].layers, layers[i].layersLength);
+    }
+}
+
+// Unloads the same textures UnloadTMX() does without freeing anything.
+void UnloadMapTextures(const TmxMap *map)
+{
+    for (uint32_t i = 0; i < map->tilesetsLength; i++)
+    {
+        const TmxTileset *tileset = &(map->tilesets[i]);
+        if (tileset->hasImage) UnloadTexture(tileset->image.texture);
+        for (uint32_t j = 0; j < tileset->tilesLength; j++)
+            if (tileset->tiles[j].hasImage) UnloadTexture(tileset->tiles[j].image.texture);
+    }
+
+    UnloadLayerTextures(map->layers, map->layersLength);
+}
+
 // Get an absolute directory path for a given file path. Returns a static string.
 // raylib's GetDirectoryPath() doesn't work as described so this is used in its place.
 const char *GetDirectoryPath2(const char *filePath)
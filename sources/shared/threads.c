@@ -0,0 +1,89 @@
+#include "shared/threads.h"
+
+#if defined(_WIN32)
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+
+_Static_assert(sizeof(ThreadMutex) == sizeof(SRWLOCK),            "ThreadMutex must hold an SRWLOCK");
+_Static_assert(sizeof(ThreadCond)  == sizeof(CONDITION_VARIABLE), "ThreadCond must hold a CONDITION_VARIABLE");
+
+static DWORD WINAPI thread_entry(LPVOID param) {
+    Thread *thread = param;
+    thread->fn(thread->arg);
+    return 0;
+}
+
+bool thread_start(Thread *thread, const ThreadFn fn, void *arg) {
+    thread->fn     = fn;
+    thread->arg    = arg;
+    thread->handle = CreateThread(NULL, 0, thread_entry, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+void thread_join(Thread *thread) {
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+}
+
+void thread_yield(void) {
+    SwitchToThread();
+}
+
+uint32_t thread_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors : 1;
+}
+
+void mutex_init   (ThreadMutex *mutex) { InitializeSRWLock((SRWLOCK *)mutex); }
+void mutex_destroy(ThreadMutex *mutex) { (void)mutex; }
+void mutex_lock   (ThreadMutex *mutex) { AcquireSRWLockExclusive((SRWLOCK *)mutex); }
+void mutex_unlock (ThreadMutex *mutex) { ReleaseSRWLockExclusive((SRWLOCK *)mutex); }
+
+void cond_init     (ThreadCond *cond) { InitializeConditionVariable((CONDITION_VARIABLE *)cond); }
+void cond_destroy  (ThreadCond *cond) { (void)cond; }
+void cond_wait     (ThreadCond *cond, ThreadMutex *mutex) { SleepConditionVariableSRW((CONDITION_VARIABLE *)cond, (SRWLOCK *)mutex, INFINITE, 0); }
+void cond_signal   (ThreadCond *cond) { WakeConditionVariable((CONDITION_VARIABLE *)cond); }
+void cond_broadcast(ThreadCond *cond) { WakeAllConditionVariable((CONDITION_VARIABLE *)cond); }
+
+#else
+  #include <sched.h>
+  #include <unistd.h>
+
+static void *thread_entry(void *param) {
+    Thread *thread = param;
+    thread->fn(thread->arg);
+    return NULL;
+}
+
+bool thread_start(Thread *thread, const ThreadFn fn, void *arg) {
+    thread->fn  = fn;
+    thread->arg = arg;
+    return pthread_create(&thread->handle, NULL, thread_entry, thread) == 0;
+}
+
+void thread_join(Thread *thread) {
+    pthread_join(thread->handle, NULL);
+}
+
+void thread_yield(void) {
+    sched_yield();
+}
+
+uint32_t thread_cpu_count(void) {
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+void mutex_init   (ThreadMutex *mutex) { pthread_mutex_init(mutex, NULL); }
+void mutex_destroy(ThreadMutex *mutex) { pthread_mutex_destroy(mutex); }
+void mutex_lock   (ThreadMutex *mutex) { pthread_mutex_lock(mutex); }
+void mutex_unlock (ThreadMutex *mutex) { pthread_mutex_unlock(mutex); }
+
+void cond_init     (ThreadCond *cond) { pthread_cond_init(cond, NULL); }
+void cond_destroy  (ThreadCond *cond) { pthread_cond_destroy(cond); }
+void cond_wait     (ThreadCond *cond, ThreadMutex *mutex) { pthread_cond_wait(cond, mutex); }
+void cond_signal   (ThreadCond *cond) { pthread_cond_signal(cond); }
+void cond_broadcast(ThreadCond *cond) { pthread_cond_broadcast(cond); }
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Minimal OS thread primitives: threads, a mutex and a condition variable.
+// Win32 on Windows, pthreads everywhere else. <windows.h> stays inside
+// threads.c; its handles are stored as pointer-sized opaque fields here so
+// this header can sit next to raylib.h.
+
+#if defined(_WIN32)
+  typedef void *ThreadHandle;                 // HANDLE
+  typedef struct { void *opaque; } ThreadMutex; // SRWLOCK
+  typedef struct { void *opaque; } ThreadCond;  // CONDITION_VARIABLE
+#else
+  #include <pthread.h>
+  typedef pthread_t       ThreadHandle;
+  typedef pthread_mutex_t ThreadMutex;
+  typedef pthread_cond_t  ThreadCond;
+#endif
+
+typedef void (*ThreadFn)(void *arg);
+
+// Owned by the caller and must stay put while the thread runs: the OS entry
+// point reads `fn` and `arg` back out of it.
+typedef struct {
+    ThreadHandle handle;
+    ThreadFn     fn;
+    void        *arg;
+} Thread;
+
+bool thread_start(Thread *thread, ThreadFn fn, void *arg);
+void thread_join (Thread *thread);
+void thread_yield(void);
+
+// Logical processors available to this process, at least 1.
+uint32_t thread_cpu_count(void);
+
+void mutex_init   (ThreadMutex *mutex);
+void mutex_destroy(ThreadMutex *mutex);
+void mutex_lock   (ThreadMutex *mutex);
+void mutex_unlock (ThreadMutex *mutex);
+
+void cond_init     (ThreadCond *cond);
+void cond_destroy  (ThreadCond *cond);
+void cond_wait     (ThreadCond *cond, ThreadMutex *mutex);
+void cond_signal   (ThreadCond *cond);
+void cond_broadcast(ThreadCond *cond);
+
+#endif //THREADS_H
@@ -0,0 +1,69 @@
+#if !defined(_WIN32)
+  #define _DEFAULT_SOURCE // MAP_ANONYMOUS and MADV_HUGEPAGE under strict -std=c17
+#endif
+#include "shared/vmem.h"
+
+#if defined(_WIN32)
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+
+size_t vmem_page_size(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+void *vmem_reserve(void *base, const size_t bytes) {
+    void *memory = VirtualAlloc(base, bytes, MEM_RESERVE, PAGE_NOACCESS);
+    if (!memory && base) memory = VirtualAlloc(NULL, bytes, MEM_RESERVE, PAGE_NOACCESS);
+    return memory;
+}
+
+void vmem_release(void *memory, const size_t bytes) {
+    (void)bytes;
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+bool vmem_commit(void *memory, const size_t bytes, const bool huge) {
+    (void)huge;
+    return VirtualAlloc(memory, bytes, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+#else
+  #include <sys/mman.h>
+  #include <unistd.h>
+
+  #if !defined(MAP_ANONYMOUS)
+    #define MAP_ANONYMOUS MAP_ANON
+  #endif
+  #if !defined(MAP_NORESERVE)
+    #define MAP_NORESERVE 0
+  #endif
+
+size_t vmem_page_size(void) {
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// `base` is only a hint: without MAP_FIXED the kernel picks another spot
+// rather than clobber a mapping that's already there.
+void *vmem_reserve(void *base, const size_t bytes) {
+    void *memory = mmap(base, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+void vmem_release(void *memory, const size_t bytes) {
+    munmap(memory, bytes);
+}
+
+bool vmem_commit(void *memory, const size_t bytes, const bool huge) {
+    if (mprotect(memory, bytes, PROT_READ | PROT_WRITE) != 0) return false;
+  #if defined(MADV_HUGEPAGE)
+    // Only whole, aligned 2 MB extents can be backed by huge pages.
+    if (huge) madvise(memory, bytes, MADV_HUGEPAGE);
+  #else
+    (void)huge;
+  #endif
+    return true;
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef VMEM_H
+#define VMEM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Address space reservation and on-demand commit. VirtualAlloc on Windows,
+// mmap/mprotect everywhere else. Reserved memory costs no RAM and faults if
+// touched; committed memory reads as zeroes and only becomes resident when
+// first written.
+#define VMEM_HUGE_PAGE_BYTES (2 * 1024 * 1024)
+
+size_t vmem_page_size(void);
+
+// Reserves `bytes` (a multiple of the page size), at `base` when that range is
+// free and anywhere otherwise: check the result. NULL on failure.
+void *vmem_reserve(void *base, size_t bytes);
+void  vmem_release(void *memory, size_t bytes);
+
+// Commits [memory, memory + bytes) of a reservation, page aligned. `huge` asks
+// for transparent huge pages on Linux; a hint, ignored where unsupported
+// (Windows large pages need a privilege and can't be committed lazily).
+bool  vmem_commit(void *memory, size_t bytes, bool huge);
+
+#endif //VMEM_H